@@ -300,6 +300,11 @@ namespace number_utils {
         add_digits(&bs, bf, bl);
         vector<ull> asbs;
         mult_digits(&asbs, as, bs);
+        for (vector<ull>* v : { &afbf, &albl, &asbs }) {
+            while (v->size() > 1 && v->back() == 0) {
+                v->pop_back();
+            }
+        }
         sub_digits_no_neg_inplace(&asbs, afbf);
         sub_digits_no_neg_inplace(&asbs, albl);
 
@@ -327,7 +332,10 @@ namespace number_utils {
             if (is_power_of_2(rhs.digits->at(0))) {
                 size_t sh = get_log(rhs.digits->at(0), 2ULL);
                 bigint q = operator>>(sh);
+                q.negative = negative != rhs.negative;
+                q.fix();
                 bigint r;
+                r.negative = negative;
                 r.digits->clear();
                 for (int i = BIGINT_BASE_BITS; i <= sh && i / BIGINT_BASE_BITS < digits->size(); i += BIGINT_BASE_BITS) {
                     r.digits->push_back(digits->at(i / BIGINT_BASE_BITS - 1));
@@ -341,7 +349,8 @@ namespace number_utils {
         }
 
         bigint q, r;
-        q.negative = r.negative = divide(q.digits, r.digits, digits, rhs.digits, negative, rhs.negative);
+        q.negative = divide(q.digits, r.digits, digits, rhs.digits, negative, rhs.negative);
+        r.negative = negative;
         r.fix();
         q.fix();
         return std::make_pair(q, r);
@@ -386,6 +395,8 @@ namespace number_utils {
                 left = A / (B + 1);
                 right = A / B;
             }
+            right = min(right, BIGINT_BASE - 1);
+            left = min(left, right);
             while (left < right) {
                 ull middle = (left + right + 1) / 2;
                 int comp = compare_mult(r, b, off, middle, false);
@@ -237,6 +237,7 @@ namespace number_utils {
                 delete digits;
                 digits = res;
             }
+            fix();
             return *this;
         }
 
@@ -254,6 +255,7 @@ namespace number_utils {
                 delete digits;
                 digits = res;
             }
+            fix();
             return *this;
         }
 
@@ -277,6 +279,7 @@ namespace number_utils {
             if (rhs.digits->size() == 1) {
                 if (is_power_of_2(rhs.digits->at(0))) {
                     res = operator<<(get_log(rhs.digits->at(0), 2ULL));
+                    res.negative = negative != rhs.negative;
                     return res;
                 }
             }
@@ -290,6 +293,7 @@ namespace number_utils {
             negative = do_mult(res, digits, rhs.digits, negative, rhs.negative);
             delete digits;
             digits = res;
+            fix();
             return *this;
         }
 
@@ -322,13 +326,13 @@ namespace number_utils {
             ull off = x / BIGINT_BASE_BITS;
             ull sh = x % BIGINT_BASE_BITS;
             res.digits->resize(off);
-            for (int i = 0; i - off < (int)digits->size(); i++) {
-                res.digits->push_back(digits->at(i - off) << sh);
-                if (i - (long long)off - 1 >= 0) {
-                    res.digits->back() += digits->at(i - off - 1) >> (32 - sh);
-                }
-                res.digits->back() %= BIGINT_BASE;
+            ull carry = 0;
+            for (size_t i = 0; i < digits->size(); i++) {
+                ull shifted = digits->at(i) << sh;
+                res.digits->push_back(shifted % BIGINT_BASE + carry);
+                carry = shifted / BIGINT_BASE;
             }
+            res.digits->push_back(carry);
             res.fix();
             return res;
         }
@@ -395,6 +399,22 @@ namespace number_utils {
         inline ull lowest_digit() const {
             return digits->at(0);
         }
+
+        inline size_t bit_length() const {
+            size_t bits = (digits->size() - 1) * BIGINT_BASE_BITS;
+            for (ull top = digits->back(); top != 0; top >>= 1) {
+                bits++;
+            }
+            return bits;
+        }
+
+        inline ull mod_small(ull m) const {
+            ull r = 0;
+            for (size_t i = digits->size(); i-- > 0;) {
+                r = ((r << BIGINT_BASE_BITS) | digits->at(i)) % m;
+            }
+            return negative && r != 0 ? m - r : r;
+        }
     };
 
     template<>
@@ -0,0 +1 @@
+#include "binary_field.hpp"
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "dense_kernels.hpp"
+
+namespace matrices {
+
+    template <int BITS, unsigned POLY>
+    class binary_field {
+        static_assert(BITS >= 2 && BITS <= 16, "Binary field needs between 2 and 16 bits");
+        static_assert(POLY >> BITS == 1, "Reduction polynomial must have degree BITS");
+
+    public:
+        typedef typename std::conditional<BITS <= 8, std::uint8_t, std::uint16_t>::type storage;
+
+    private:
+        struct tables {
+            std::vector<std::uint16_t> log, exp;
+
+            tables() : log(size()), exp(2 * size()) {
+                unsigned x = 1;
+                for (unsigned i = 0; i < size() - 1; i++) {
+                    do_assert(i == 0 || x != 1, "Reduction polynomial is not primitive");
+                    exp[i] = x;
+                    log[x] = i;
+                    x <<= 1;
+                    if (x >> BITS)
+                        x ^= POLY;
+                }
+                for (unsigned i = size() - 1; i < 2 * size(); i++) {
+                    exp[i] = exp[i - (size() - 1)];
+                }
+            }
+        };
+
+        static inline const tables& table() {
+            static const tables t;
+            return t;
+        }
+
+        storage val;
+
+    public:
+        inline binary_field() : val(0) { }
+        inline binary_field(unsigned value) : val(value & (size() - 1)) { }
+
+        inline const storage& value() const {
+            return val;
+        }
+
+        static constexpr inline unsigned size() {
+            return 1u << BITS;
+        }
+
+        inline bool operator==(const binary_field<BITS, POLY>& rhs) const {
+            return val == rhs.val;
+        }
+
+        inline bool operator!=(const binary_field<BITS, POLY>& rhs) const {
+            return val != rhs.val;
+        }
+
+        inline binary_field<BITS, POLY> operator+(const binary_field<BITS, POLY>& rhs) const {
+            return binary_field<BITS, POLY>(val ^ rhs.val);
+        }
+
+        inline binary_field<BITS, POLY>& operator+=(const binary_field<BITS, POLY>& rhs) {
+            val ^= rhs.val;
+            return *this;
+        }
+
+        inline binary_field<BITS, POLY> operator-() const {
+            return *this;
+        }
+
+        inline binary_field<BITS, POLY> operator-(const binary_field<BITS, POLY>& rhs) const {
+            return *this + rhs;
+        }
+
+        inline binary_field<BITS, POLY>& operator-=(const binary_field<BITS, POLY>& rhs) {
+            return *this += rhs;
+        }
+
+        inline binary_field<BITS, POLY> operator*(const binary_field<BITS, POLY>& rhs) const {
+            if (val == 0 || rhs.val == 0)
+                return binary_field<BITS, POLY>();
+            const tables& t = table();
+            return binary_field<BITS, POLY>(t.exp[t.log[val] + t.log[rhs.val]]);
+        }
+
+        inline binary_field<BITS, POLY>& operator*=(const binary_field<BITS, POLY>& rhs) {
+            return *this = *this * rhs;
+        }
+
+        inline binary_field<BITS, POLY> inverse() const {
+            do_assert(val != 0, "Cannot invert zero");
+            const tables& t = table();
+            return binary_field<BITS, POLY>(t.exp[size() - 1 - t.log[val]]);
+        }
+
+        inline binary_field<BITS, POLY> operator^(int power) const {
+            if (power == 0)
+                return binary_field<BITS, POLY>(1);
+            if (val == 0)
+                return *this;
+            const tables& t = table();
+            long long e = (long long)t.log[val] * power % (size() - 1);
+            return binary_field<BITS, POLY>(t.exp[e < 0 ? e + size() - 1 : e]);
+        }
+
+        inline binary_field<BITS, POLY>& operator^=(int power) {
+            return *this = *this ^ power;
+        }
+
+        inline binary_field<BITS, POLY> operator/(const binary_field<BITS, POLY>& rhs) const {
+            return *this * rhs.inverse();
+        }
+
+        inline binary_field<BITS, POLY>& operator/=(const binary_field<BITS, POLY>& rhs) {
+            return *this = *this / rhs;
+        }
+    };
+
+    using gf256 = binary_field<8, 0x11D>;
+
+    using gf65536 = binary_field<16, 0x1100B>;
+
+    namespace helper {
+
+        template <int BITS, unsigned POLY>
+        struct exact_field<binary_field<BITS, POLY>> {
+            static constexpr bool enabled = true;
+        };
+
+        template <int BITS, unsigned POLY>
+        struct row_kernel<binary_field<BITS, POLY>> {
+            typedef binary_field<BITS, POLY> field;
+            typedef typename field::storage storage;
+            static constexpr bool specialized = true;
+            static constexpr int nibbles = (BITS + 3) / 4;
+            static_assert(sizeof(field) == sizeof(storage), "Binary field elements must be stored without padding");
+
+            struct multiplier {
+                storage table[nibbles][16];
+
+                explicit multiplier(const field& mult) {
+                    unsigned x = mult.value();
+                    for (int n = 0; n < nibbles; n++) {
+                        table[n][0] = 0;
+                        for (int b = 0; b < 4; b++) {
+                            table[n][1 << b] = x;
+                            for (int low = 1; low < (1 << b); low++) {
+                                table[n][(1 << b) | low] = x ^ table[n][low];
+                            }
+                            x <<= 1;
+                            if (x >> BITS)
+                                x ^= POLY;
+                        }
+                    }
+                }
+            };
+
+            static const multiplier& cached(const field& mult) {
+                static_assert(BITS <= 8, "Only small binary fields cache every multiplier");
+                static const std::vector<multiplier> all = []() {
+                    std::vector<multiplier> out;
+                    out.reserve(field::size());
+                    for (unsigned m = 0; m < field::size(); m++) {
+                        out.emplace_back(field(m));
+                    }
+                    return out;
+                }();
+                return all[mult.value()];
+            }
+
+            static void subtract_multiple(field* row, const field* src, int cols, const multiplier& mult) {
+                int j = 0;
+#ifdef __SSSE3__
+                if constexpr (BITS == 8) {
+                    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mult.table[0]));
+                    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mult.table[1]));
+                    const __m128i mask = _mm_set1_epi8(0x0F);
+                    for (; j + 16 <= cols; j += 16) {
+                        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + j));
+                        __m128i product = _mm_xor_si128(_mm_shuffle_epi8(low, _mm_and_si128(x, mask)),
+                                                        _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi64(x, 4), mask)));
+                        __m128i* out = reinterpret_cast<__m128i*>(row + j);
+                        _mm_storeu_si128(out, _mm_xor_si128(_mm_loadu_si128(out), product));
+                    }
+                }
+#endif
+                for (; j < cols; j++) {
+                    storage x = src[j].value(), product = 0;
+                    for (int n = 0; n < nibbles; n++) {
+                        product ^= mult.table[n][x >> (4 * n) & 15];
+                    }
+                    row[j] += field(product);
+                }
+            }
+
+            static void subtract_multiple(field* row, const field* src, int cols, const field& mult) {
+                if (mult == field())
+                    return;
+                if constexpr (BITS <= 8)
+                    subtract_multiple(row, src, cols, cached(mult));
+                else
+                    subtract_multiple(row, src, cols, multiplier(mult));
+            }
+        };
+
+    }
+
+}
+
+namespace number_utils {
+
+    template <int BITS, unsigned POLY>
+    struct standard_numbers<matrices::binary_field<BITS, POLY>> {
+        static inline matrices::binary_field<BITS, POLY> zero() {
+            return matrices::binary_field<BITS, POLY>(0);
+        }
+
+        static inline matrices::binary_field<BITS, POLY> one() {
+            return matrices::binary_field<BITS, POLY>(1);
+        }
+
+        static inline matrices::binary_field<BITS, POLY> minus_one() {
+            return matrices::binary_field<BITS, POLY>(1);
+        }
+
+        static inline matrices::binary_field<BITS, POLY> zero(const matrices::binary_field<BITS, POLY>& sample) {
+            return matrices::binary_field<BITS, POLY>(0);
+        }
+
+        static inline matrices::binary_field<BITS, POLY> one(const matrices::binary_field<BITS, POLY>& sample) {
+            return matrices::binary_field<BITS, POLY>(1);
+        }
+
+        static inline matrices::binary_field<BITS, POLY> minus_one(const matrices::binary_field<BITS, POLY>& sample) {
+            return matrices::binary_field<BITS, POLY>(1);
+        }
+    };
+
+}
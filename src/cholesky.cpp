@@ -0,0 +1 @@
+#include "cholesky.hpp"
@@ -0,0 +1,422 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "assert.hpp"
+#include "parallel.hpp"
+#include "dense_kernels.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    namespace helper {
+
+        template <typename T>
+        struct ldlt_impl {
+            static constexpr int block = 64;
+            static constexpr int parallel_rows = 256;
+
+            static bool factor_block(std::vector<T>& a, int n, int k0, int w, std::vector<T>& d) {
+                for (int j = k0; j < k0 + w; j++) {
+                    T* aj = &a[(size_t)j * n];
+                    d[j] = aj[j];
+                    aj[j] = 1;
+                    if (!(d[j] > 0))
+                        return false;
+                    for (int i = j + 1; i < k0 + w; i++) {
+                        T* ai = &a[(size_t)i * n];
+                        T t = ai[j];
+                        T l = t / d[j];
+                        for (int c = j + 1; c < i; c++) {
+                            ai[c] -= t * a[(size_t)c * n + j];
+                        }
+                        ai[i] -= t * l;
+                        ai[j] = l;
+                    }
+                }
+                return true;
+            }
+
+            static void solve_panel(std::vector<T>& a, int n, int k0, int w, const std::vector<T>& d, std::vector<T>& y, int r0, int r1) {
+                int start = k0 + w;
+                for (int r = r0; r < r1; r++) {
+                    T* ar = &a[(size_t)r * n];
+                    T* yr = &y[(size_t)(r - start) * w];
+                    for (int j = 0; j < w; j++) {
+                        T sum = ar[k0 + j];
+                        const T* lj = &a[(size_t)(k0 + j) * n + k0];
+                        for (int c = 0; c < j; c++) {
+                            sum -= yr[c] * lj[c];
+                        }
+                        yr[j] = sum;
+                        ar[k0 + j] = sum / d[k0 + j];
+                    }
+                }
+            }
+
+            // Blocked factorization without pivoting, stopped at the first pivot that is not positive.
+            // Returns whether the matrix is positive definite (then no pivoting is needed for stability).
+            static bool factorize(std::vector<T>& a, int n, std::vector<T>& d) {
+                d.assign(n, 0);
+                for (int k0 = 0; k0 < n; k0 += block) {
+                    int w = std::min(block, n - k0), start = k0 + w, rest = n - start;
+                    if (!factor_block(a, n, k0, w, d))
+                        return false;
+                    if (rest == 0)
+                        break;
+
+                    std::vector<T> y((size_t)rest * w), lt((size_t)w * rest);
+                    int chunks = (rest + block - 1) / block;
+                    auto panel = [&](int c) {
+                        int r0 = start + c * block, r1 = std::min(n, r0 + block);
+                        solve_panel(a, n, k0, w, d, y, r0, r1);
+                    };
+                    auto update = [&](int c) {
+                        int r0 = start + c * block, r1 = std::min(n, r0 + block);
+                        dense_kernels<T>::gemm_subtract(&a[(size_t)r0 * n + start], n, &y[(size_t)(r0 - start) * w], w,
+                                                        lt.data(), rest, r1 - r0, w, r1 - start);
+                    };
+                    if (rest >= parallel_rows)
+                        parallel_for(0, chunks, panel);
+                    else
+                        for (int c = 0; c < chunks; c++) panel(c);
+                    for (int r = 0; r < rest; r++) {
+                        for (int j = 0; j < w; j++) {
+                            lt[(size_t)j * rest + r] = a[(size_t)(start + r) * n + k0 + j];
+                        }
+                    }
+                    if (rest >= parallel_rows)
+                        parallel_for(0, chunks, update);
+                    else
+                        for (int c = 0; c < chunks; c++) update(c);
+                }
+                for (int i = 0; i < n; i++) {
+                    for (int j = i + 1; j < n; j++) {
+                        a[(size_t)i * n + j] = 0;
+                    }
+                }
+                return true;
+            }
+
+            static void swap_symmetric(std::vector<T>& a, int n, int p, int q) {
+                for (int c = 0; c < p; c++) {
+                    std::swap(a[(size_t)p * n + c], a[(size_t)q * n + c]);
+                }
+                std::swap(a[(size_t)p * n + p], a[(size_t)q * n + q]);
+                for (int j = p + 1; j < q; j++) {
+                    std::swap(a[(size_t)j * n + p], a[(size_t)q * n + j]);
+                }
+                for (int i = q + 1; i < n; i++) {
+                    std::swap(a[(size_t)i * n + p], a[(size_t)i * n + q]);
+                }
+            }
+
+            // Bunch-Kaufman factorization P A P^T = L D L^T with 1x1 and 2x2 diagonal blocks, on the lower triangle.
+            // e[k] is the off-diagonal element of a 2x2 block starting at k (zero elsewhere), perm[i] the row of A moved to i.
+            static void factorize_pivoted(std::vector<T>& a, int n, std::vector<T>& d, std::vector<T>& e, std::vector<int>& perm) {
+                const T alpha = (1 + std::sqrt(T(17))) / 8;
+                auto at = [&](int i, int j) -> T& { return i >= j ? a[(size_t)i * n + j] : a[(size_t)j * n + i]; };
+                d.assign(n, 0);
+                e.assign(n, 0);
+                perm.resize(n);
+                for (int i = 0; i < n; i++) {
+                    perm[i] = i;
+                }
+                std::vector<T> t0(n), t1(n);
+                for (int k = 0; k < n;) {
+                    T absakk = std::abs(at(k, k)), colmax = 0;
+                    int imax = k, step = 1, pivot = k;
+                    for (int i = k + 1; i < n; i++) {
+                        if (std::abs(at(i, k)) > colmax) {
+                            colmax = std::abs(at(i, k));
+                            imax = i;
+                        }
+                    }
+                    if (absakk < alpha * colmax) {
+                        T rowmax = 0;
+                        for (int j = k; j < n; j++) {
+                            if (j != imax)
+                                rowmax = std::max(rowmax, std::abs(at(imax, j)));
+                        }
+                        if (absakk * rowmax < alpha * colmax * colmax) {
+                            pivot = imax;
+                            if (std::abs(at(imax, imax)) < alpha * rowmax)
+                                step = 2;
+                        }
+                    }
+                    int target = k + step - 1;
+                    if (pivot != target) {
+                        swap_symmetric(a, n, target, pivot);
+                        std::swap(perm[target], perm[pivot]);
+                    }
+
+                    if (step == 1) {
+                        T dk = d[k] = at(k, k);
+                        at(k, k) = 1;
+                        for (int i = k + 1; i < n; i++) {
+                            t0[i] = at(i, k);
+                            at(i, k) = dk == 0 ? 0 : t0[i] / dk;
+                        }
+                        if (dk != 0) {
+                            for (int i = k + 1; i < n; i++) {
+                                T* ai = &a[(size_t)i * n];
+                                T l = ai[k];
+                                for (int j = k + 1; j <= i; j++) {
+                                    ai[j] -= l * t0[j];
+                                }
+                            }
+                        }
+                    } else {
+                        T d11 = d[k] = at(k, k), d21 = e[k] = at(k + 1, k), d22 = d[k + 1] = at(k + 1, k + 1);
+                        T det = d11 * d22 - d21 * d21;
+                        at(k, k) = at(k + 1, k + 1) = 1;
+                        at(k + 1, k) = 0;
+                        for (int i = k + 2; i < n; i++) {
+                            t0[i] = at(i, k);
+                            t1[i] = at(i, k + 1);
+                            at(i, k) = (d22 * t0[i] - d21 * t1[i]) / det;
+                            at(i, k + 1) = (d11 * t1[i] - d21 * t0[i]) / det;
+                        }
+                        for (int i = k + 2; i < n; i++) {
+                            T* ai = &a[(size_t)i * n];
+                            T l0 = ai[k], l1 = ai[k + 1];
+                            for (int j = k + 2; j <= i; j++) {
+                                ai[j] -= l0 * t0[j] + l1 * t1[j];
+                            }
+                        }
+                    }
+                    k += step;
+                }
+                for (int i = 0; i < n; i++) {
+                    for (int j = i + 1; j < n; j++) {
+                        a[(size_t)i * n + j] = 0;
+                    }
+                }
+            }
+        };
+
+    }
+
+    template <typename T>
+    class ldlt_decomposition {
+        int n;
+        std::vector<T> l, lt, d, e;
+        std::vector<int> perm;
+        bool definite;
+
+        std::vector<T> to_vector(const dynamic_matrix<T>& b) const {
+            do_assert(b.rows() == n, "Incompatible matrix dimensions for LDL^T solve");
+            do_assert(!is_singular(), "Cannot solve the system - singular");
+            std::vector<T> out((size_t)b.rows() * b.cols());
+            for (int i = 0; i < b.rows(); i++) {
+                for (int j = 0; j < b.cols(); j++) {
+                    out[(size_t)i * b.cols() + j] = b.element(perm[i], j);
+                }
+            }
+            return out;
+        }
+
+        void substitute(std::vector<T>& x, int cols) const {
+            helper::dense_kernels<T>::trsm_lower(l.data(), n, x.data(), cols, n, cols, true);
+            for (int i = 0; i < n; i++) {
+                T* xi = &x[(size_t)i * cols];
+                if (e[i] == 0) {
+                    for (int j = 0; j < cols; j++) {
+                        xi[j] /= d[i];
+                    }
+                    continue;
+                }
+                T* xn = xi + cols;
+                T det = d[i] * d[i + 1] - e[i] * e[i];
+                for (int j = 0; j < cols; j++) {
+                    T x0 = xi[j], x1 = xn[j];
+                    xi[j] = (d[i + 1] * x0 - e[i] * x1) / det;
+                    xn[j] = (d[i] * x1 - e[i] * x0) / det;
+                }
+                i++;
+            }
+            helper::dense_kernels<T>::trsm_upper(lt.data(), n, x.data(), cols, n, cols, true);
+        }
+
+        void copy_lower(const dynamic_matrix<T>& a) {
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j <= i; j++) {
+                    l[(size_t)i * n + j] = a.element(i, j);
+                }
+            }
+        }
+
+    public:
+        explicit ldlt_decomposition(const dynamic_matrix<T>& a) : n(a.rows()), l((size_t)a.rows() * a.rows()), lt((size_t)a.rows() * a.rows()) {
+            do_assert(a.rows() == a.cols(), "Must be a square matrix");
+            copy_lower(a);
+            definite = helper::ldlt_impl<T>::factorize(l, n, d);
+            if (definite) {
+                e.assign(n, 0);
+                perm.resize(n);
+                std::iota(perm.begin(), perm.end(), 0);
+            } else {
+                copy_lower(a);
+                helper::ldlt_impl<T>::factorize_pivoted(l, n, d, e, perm);
+            }
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j <= i; j++) {
+                    lt[(size_t)j * n + i] = l[(size_t)i * n + j];
+                }
+            }
+        }
+
+        inline int size() const {
+            return n;
+        }
+
+        bool is_singular() const {
+            for (int i = 0; i < n; i++) {
+                if (e[i] != 0) {
+                    if (d[i] * d[i + 1] - e[i] * e[i] == 0)
+                        return true;
+                    i++;
+                } else if (d[i] == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        inline bool is_positive_definite() const {
+            return definite;
+        }
+
+        dynamic_matrix<T> lower() const {
+            dynamic_matrix<T> out(n, n);
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    out.element(i, j) = l[(size_t)i * n + j];
+                }
+            }
+            return out;
+        }
+
+        // Main diagonal of the block diagonal D.
+        inline const std::vector<T>& diagonal() const {
+            return d;
+        }
+
+        // Off-diagonal elements of D: subdiagonal()[k] != 0 marks a 2x2 block in rows k, k + 1.
+        inline const std::vector<T>& subdiagonal() const {
+            return e;
+        }
+
+        // P A P^T = L D L^T, where row i of P A P^T is row permutation()[i] of A.
+        inline const std::vector<int>& permutation() const {
+            return perm;
+        }
+
+        T determinant() const {
+            T det = 1;
+            for (int i = 0; i < n; i++) {
+                if (e[i] != 0) {
+                    det *= d[i] * d[i + 1] - e[i] * e[i];
+                    i++;
+                } else {
+                    det *= d[i];
+                }
+            }
+            return det;
+        }
+
+        T log_abs_determinant() const {
+            T sum = 0;
+            for (int i = 0; i < n; i++) {
+                if (e[i] != 0) {
+                    sum += std::log(std::abs(d[i] * d[i + 1] - e[i] * e[i]));
+                    i++;
+                } else {
+                    sum += std::log(std::abs(d[i]));
+                }
+            }
+            return sum;
+        }
+
+        std::vector<T> solve(const std::vector<T>& b) const {
+            do_assert((int)b.size() == n, "Incompatible matrix dimensions for LDL^T solve");
+            do_assert(!is_singular(), "Cannot solve the system - singular");
+            std::vector<T> x(n);
+            for (int i = 0; i < n; i++) {
+                x[i] = b[perm[i]];
+            }
+            substitute(x, 1);
+            std::vector<T> out(n);
+            for (int i = 0; i < n; i++) {
+                out[perm[i]] = x[i];
+            }
+            return out;
+        }
+
+        dynamic_matrix<T> solve(const dynamic_matrix<T>& b) const {
+            std::vector<T> x = to_vector(b);
+            substitute(x, b.cols());
+            dynamic_matrix<T> out(b.rows(), b.cols());
+            for (int i = 0; i < b.rows(); i++) {
+                for (int j = 0; j < b.cols(); j++) {
+                    out.element(perm[i], j) = x[(size_t)i * b.cols() + j];
+                }
+            }
+            return out;
+        }
+
+        std::pair<dynamic_matrix<T>, bool> inverse() const {
+            if (is_singular())
+                return std::make_pair(dynamic_matrix<T>(n, n, 0), false);
+            return std::make_pair(solve(dynamic_matrix<T>::identity(n)), true);
+        }
+    };
+
+    template <typename T>
+    class cholesky_decomposition {
+        ldlt_decomposition<T> ldlt;
+
+    public:
+        explicit cholesky_decomposition(const dynamic_matrix<T>& a) : ldlt(a) { }
+
+        inline bool is_positive_definite() const {
+            return ldlt.is_positive_definite();
+        }
+
+        dynamic_matrix<T> lower() const {
+            do_assert(is_positive_definite(), "Matrix is not positive definite");
+            dynamic_matrix<T> out = ldlt.lower();
+            for (int j = 0; j < ldlt.size(); j++) {
+                T scale = std::sqrt(ldlt.diagonal()[j]);
+                for (int i = j; i < ldlt.size(); i++) {
+                    out.element(i, j) *= scale;
+                }
+            }
+            return out;
+        }
+
+        T log_determinant() const {
+            do_assert(is_positive_definite(), "Matrix is not positive definite");
+            return ldlt.log_abs_determinant();
+        }
+
+        std::vector<T> solve(const std::vector<T>& b) const {
+            do_assert(is_positive_definite(), "Matrix is not positive definite");
+            return ldlt.solve(b);
+        }
+
+        dynamic_matrix<T> solve(const dynamic_matrix<T>& b) const {
+            do_assert(is_positive_definite(), "Matrix is not positive definite");
+            return ldlt.solve(b);
+        }
+
+        std::pair<dynamic_matrix<T>, bool> inverse() const {
+            if (!is_positive_definite())
+                return std::make_pair(dynamic_matrix<T>(ldlt.size(), ldlt.size(), 0), false);
+            return ldlt.inverse();
+        }
+    };
+
+}
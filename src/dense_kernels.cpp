@@ -0,0 +1 @@
+#include "dense_kernels.hpp"
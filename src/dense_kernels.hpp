@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include "numbers.hpp"
+#include "number_types.hpp"
+#include "parallel.hpp"
+
+namespace matrices {
+
+    namespace helper {
+
+        template <typename T>
+        struct floating_point_gemm {
+            static constexpr bool candidate = false;
+
+            static inline bool usable(const T& sample) {
+                return false;
+            }
+
+            static inline double modulus(const T& sample) {
+                return 0;
+            }
+
+            static inline T make(const T& sample, double value) {
+                return sample;
+            }
+        };
+
+        template <typename U>
+        struct floating_point_gemm<finite_field<U>> {
+            static constexpr bool candidate = std::is_integral<U>::value;
+
+            static inline bool usable(const finite_field<U>& sample) {
+                return sample.size() > 1 && sample.size() < (1 << 26);
+            }
+
+            static inline double modulus(const finite_field<U>& sample) {
+                return sample.size();
+            }
+
+            static inline finite_field<U> make(const finite_field<U>& sample, double value) {
+                return finite_field<U>(sample.size(), (U)value);
+            }
+        };
+
+        template <typename U, U P>
+        struct floating_point_gemm<finite_field_template<U, P>> {
+            static constexpr bool candidate = P > 1 && P < (U(1) << 26);
+
+            static inline bool usable(const finite_field_template<U, P>& sample) {
+                return true;
+            }
+
+            static inline double modulus(const finite_field_template<U, P>& sample) {
+                return P;
+            }
+
+            static inline finite_field_template<U, P> make(const finite_field_template<U, P>& sample, double value) {
+                return finite_field_template<U, P>((U)value);
+            }
+        };
+
+        template <typename T>
+        struct exact_field {
+            static constexpr bool enabled = false;
+        };
+
+        template <typename U>
+        struct exact_field<finite_field<U>> {
+            static constexpr bool enabled = true;
+        };
+
+        template <typename U, U P>
+        struct exact_field<finite_field_template<U, P>> {
+            static constexpr bool enabled = true;
+        };
+
+        inline void multiply_mod_double(const double* a, const double* b, double* c, int rows, int inner, int cols, double p) {
+            const double exact_limit = 9007199254740992.0;
+            const int block = 256;
+            int chunk = (int)std::max(1.0, std::min((double)block, (exact_limit - p) / ((p - 1) * (p - 1))));
+            for (int j0 = 0; j0 < cols; j0 += block) {
+                int j1 = std::min(cols, j0 + block);
+                for (int k0 = 0; k0 < inner; k0 += chunk) {
+                    int k1 = std::min(inner, k0 + chunk);
+                    for (int i = 0; i < rows; i++) {
+                        double* ci = c + (size_t)i * cols;
+                        for (int k = k0; k < k1; k++) {
+                            double x = a[(size_t)i * inner + k];
+                            if (x == 0)
+                                continue;
+                            const double* bk = b + (size_t)k * cols;
+                            for (int j = j0; j < j1; j++) {
+                                ci[j] += x * bk[j];
+                            }
+                        }
+                        for (int j = j0; j < j1; j++) {
+                            double r = ci[j] - std::floor(ci[j] / p) * p;
+                            ci[j] = r < 0 ? r + p : r >= p ? r - p : r;
+                        }
+                    }
+                }
+            }
+        }
+
+        template <typename T>
+        struct semiring_gemm {
+            static constexpr bool specialized = false;
+        };
+
+        template <typename T>
+        struct row_kernel {
+            static constexpr bool specialized = false;
+
+            static inline void subtract_multiple(T* row, const T* src, int cols, const T& mult) {
+                for (int j = 0; j < cols; j++) {
+                    row[j] -= mult * src[j];
+                }
+            }
+        };
+
+        template <typename T>
+        struct dense_kernels {
+            static constexpr int base_size = 32;
+
+            static void gemm_subtract(T* c, int ldc, const T* a, int lda, const T* b, int ldb, int rows, int inner, int cols) {
+                if (rows == 0 || inner == 0 || cols == 0)
+                    return;
+                const T& sample = c[0];
+                if constexpr (floating_point_gemm<T>::candidate) {
+                    if ((long long)rows * inner * cols >= (long long)base_size * base_size * base_size && floating_point_gemm<T>::usable(sample)) {
+                        std::vector<double> da((size_t)rows * inner), db((size_t)inner * cols), dc((size_t)rows * cols, 0.0);
+                        for (int i = 0; i < rows; i++) {
+                            for (int k = 0; k < inner; k++) {
+                                da[(size_t)i * inner + k] = a[(size_t)i * lda + k].value();
+                            }
+                        }
+                        for (int k = 0; k < inner; k++) {
+                            for (int j = 0; j < cols; j++) {
+                                db[(size_t)k * cols + j] = b[(size_t)k * ldb + j].value();
+                            }
+                        }
+                        multiply_mod_double(da.data(), db.data(), dc.data(), rows, inner, cols, floating_point_gemm<T>::modulus(sample));
+                        for (int i = 0; i < rows; i++) {
+                            for (int j = 0; j < cols; j++) {
+                                c[(size_t)i * ldc + j] -= floating_point_gemm<T>::make(sample, dc[(size_t)i * cols + j]);
+                            }
+                        }
+                        return;
+                    }
+                }
+                const T zero = number_utils::get_zero<T>(sample);
+                for (int i = 0; i < rows; i++) {
+                    T* ci = c + (size_t)i * ldc;
+                    for (int k = 0; k < inner; k++) {
+                        const T& x = a[(size_t)i * lda + k];
+                        if (x == zero)
+                            continue;
+                        subtract_row(ci, b + (size_t)k * ldb, cols, x);
+                    }
+                }
+            }
+
+            static void parallel_gemm_subtract(T* c, int ldc, const T* a, int lda, const T* b, int ldb, int rows, int inner, int cols) {
+                const int chunk = 64;
+                if (rows < 4 * chunk) {
+                    gemm_subtract(c, ldc, a, lda, b, ldb, rows, inner, cols);
+                    return;
+                }
+                parallel_for(0, (rows + chunk - 1) / chunk, [&](int t) {
+                    int r0 = t * chunk, r1 = std::min(rows, r0 + chunk);
+                    gemm_subtract(c + (size_t)r0 * ldc, ldc, a + (size_t)r0 * lda, lda, b, ldb, r1 - r0, inner, cols);
+                });
+            }
+
+            static void trsm_lower(const T* l, int ldl, T* b, int ldb, int n, int cols, bool unit) {
+                if (n <= base_size) {
+                    for (int i = 0; i < n; i++) {
+                        gemm_subtract(b + (size_t)i * ldb, ldb, l + (size_t)i * ldl, ldl, b, ldb, 1, i, cols);
+                        if (!unit)
+                            scale_row(b + (size_t)i * ldb, cols, l[(size_t)i * ldl + i]);
+                    }
+                    return;
+                }
+                int h = n / 2;
+                trsm_lower(l, ldl, b, ldb, h, cols, unit);
+                gemm_subtract(b + (size_t)h * ldb, ldb, l + (size_t)h * ldl, ldl, b, ldb, n - h, h, cols);
+                trsm_lower(l + (size_t)h * ldl + h, ldl, b + (size_t)h * ldb, ldb, n - h, cols, unit);
+            }
+
+            static void trsm_upper(const T* u, int ldu, T* b, int ldb, int n, int cols, bool unit) {
+                if (n <= base_size) {
+                    for (int i = n - 1; i >= 0; i--) {
+                        gemm_subtract(b + (size_t)i * ldb, ldb, u + (size_t)i * ldu + i + 1, ldu, b + (size_t)(i + 1) * ldb, ldb, 1, n - i - 1, cols);
+                        if (!unit)
+                            scale_row(b + (size_t)i * ldb, cols, u[(size_t)i * ldu + i]);
+                    }
+                    return;
+                }
+                int h = n / 2;
+                trsm_upper(u + (size_t)h * ldu + h, ldu, b + (size_t)h * ldb, ldb, n - h, cols, unit);
+                gemm_subtract(b, ldb, u + h, ldu, b + (size_t)h * ldb, ldb, h, n - h, cols);
+                trsm_upper(u, ldu, b, ldb, h, cols, unit);
+            }
+
+            static inline void subtract_row(T* row, const T* pivot_row, int cols, const T& mult) {
+                row_kernel<T>::subtract_multiple(row, pivot_row, cols, mult);
+            }
+
+            static inline void scale_row(T* row, int cols, const T& divisor) {
+                T inv = number_utils::get_one<T>(divisor) / divisor;
+                for (int j = 0; j < cols; j++) {
+                    row[j] *= inv;
+                }
+            }
+        };
+
+    }
+
+}
@@ -0,0 +1,161 @@
+#include <cmath>
+#include "dixon.hpp"
+
+using namespace std;
+using namespace number_utils;
+typedef unsigned long long ull;
+
+namespace matrices {
+
+    namespace helper {
+
+        bigint dixon_impl::int128_to_bigint(__int128 x) {
+            bool neg = x < 0;
+            unsigned __int128 u = neg ? -(unsigned __int128)x : (unsigned __int128)x;
+            bigint res = (bigint((ull)(u >> 64)) << 64) + bigint((ull)u);
+            return neg ? -res : res;
+        }
+
+        void dixon_impl::subtract_product(vector<bigint>& r, const vector<bigint>& a, const vector<long long>& small_a,
+                                          const vector<ull>& x, int n, int k) {
+            for (int i = 0; i < n; i++) {
+                for (int c = 0; c < k; c++) {
+                    if (!small_a.empty()) {
+                        __int128 acc = 0;
+                        for (int j = 0; j < n; j++) {
+                            acc += (__int128)small_a[i * n + j] * (long long)x[j * k + c];
+                        }
+                        r[i * k + c] -= int128_to_bigint(acc);
+                    } else {
+                        for (int j = 0; j < n; j++) {
+                            if (x[j * k + c] != 0)
+                                r[i * k + c] -= a[i * n + j] * bigint(x[j * k + c]);
+                        }
+                    }
+                }
+            }
+        }
+
+        bool dixon_impl::verify_solution(const vector<bigint>& a, const vector<bigint>& b,
+                                         const vector<bigint>& numers, const bigint& denom, int n, int k) {
+            for (int i = 0; i < n; i++) {
+                for (int c = 0; c < k; c++) {
+                    bigint sum = 0;
+                    for (int j = 0; j < n; j++) {
+                        sum += a[i * n + j] * numers[j * k + c];
+                    }
+                    if (sum != denom * b[i * k + c])
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        pair<dynamic_matrix<fraction<bigint>>, bool> dixon_impl::solve(const vector<bigint>& a, const vector<bigint>& b, int n, int k) {
+            dynamic_matrix<fraction<bigint>> out(n, k, fraction<bigint>(bigint(0)));
+            double hadamard = multimodular_impl::hadamard_bound_bits(a, n);
+            if (hadamard < 0)
+                return make_pair(out, false);
+
+            double bound_bits = 1;
+            bool small = true;
+            for (int i = 0; i < n; i++) {
+                size_t row_bits = 0;
+                for (int j = 0; j < n; j++) {
+                    row_bits = max(row_bits, a[i * n + j].bit_length());
+                    small = small && a[i * n + j].bit_length() <= 32;
+                }
+                for (int c = 0; c < k; c++) {
+                    row_bits = max(row_bits, b[i * k + c].bit_length());
+                }
+                bound_bits += 2 * (row_bits + 0.5 * log2(n + 1));
+            }
+            vector<long long> small_a;
+            if (small) {
+                small_a.resize(n * n);
+                for (int e = 0; e < n * n; e++) {
+                    small_a[e] = a[e].is_negative() ? -(long long)a[e].lowest_digit() : (long long)a[e].lowest_digit();
+                }
+            }
+
+            ull p = 0;
+            vector<ull> inverse;
+            double bad_bits = 0;
+            ull next_bound = WORD_PRIME_BOUND;
+            while (p == 0) {
+                vector<ull> primes = primes_below(next_bound, 64);
+                do_assert(!primes.empty(), "Could not find a prime for p-adic lifting");
+                next_bound = primes.back();
+                for (ull candidate : primes) {
+                    if (multimodular_impl::inverse_mod_p(a, n, candidate, inverse)) {
+                        p = candidate;
+                        break;
+                    }
+                    bad_bits += log2(candidate);
+                    if (bad_bits > hadamard)
+                        return make_pair(out, false);
+                }
+            }
+
+            vector<bigint> r = b, x(n * k, bigint(0)), numers;
+            vector<ull> digit(n * k), residue(n * k);
+            bigint power = 1, denom;
+            double power_bits = 0, next_check = 64;
+            while (true) {
+                for (int e = 0; e < n * k; e++) {
+                    residue[e] = r[e].mod_small(p);
+                }
+                for (int i = 0; i < n; i++) {
+                    for (int c = 0; c < k; c++) {
+                        ull sum = 0;
+                        for (int j = 0; j < n; j++) {
+                            sum = (sum + mul_mod(inverse[i * n + j], residue[j * k + c], p)) % p;
+                        }
+                        digit[i * k + c] = sum;
+                    }
+                }
+                subtract_product(r, a, small_a, digit, n, k);
+                bigint bp(p);
+                for (int e = 0; e < n * k; e++) {
+                    r[e] /= bp;
+                    if (digit[e] != 0)
+                        x[e] += power * bigint(digit[e]);
+                }
+                power *= bp;
+                power_bits += log2(p);
+
+                if (power_bits >= next_check || power_bits > bound_bits) {
+                    next_check = power_bits * 2;
+                    if (rational_reconstruction(x[n * k - 1], power).second &&
+                        multimodular_impl::reconstruct(x, power, numers, denom) && verify_solution(a, b, numers, denom, n, k)) {
+                        for (int i = 0; i < n; i++) {
+                            for (int c = 0; c < k; c++) {
+                                out[i][c] = fraction<bigint>(numers[i * k + c], denom);
+                            }
+                        }
+                        return make_pair(out, true);
+                    }
+                    do_assert(power_bits <= bound_bits + 64, "p-adic lifting failed to converge");
+                }
+            }
+        }
+
+    }
+
+    pair<dynamic_matrix<fraction<bigint>>, bool> solve_dixon(const dynamic_matrix<bigint>& a, const dynamic_matrix<bigint>& b) {
+        do_assert(a.rows() == a.cols(), "Must be a square matrix");
+        do_assert(a.rows() == b.rows(), "Incompatible matrix dimensions for solving");
+        int n = a.rows(), k = b.cols();
+        vector<bigint> av(n * n), bv(n * k);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                av[i * n + j] = a.element(i, j);
+            }
+            for (int c = 0; c < k; c++) {
+                bv[i * k + c] = b.element(i, c);
+            }
+        }
+        return helper::dixon_impl::solve(av, bv, n, k);
+    }
+
+}
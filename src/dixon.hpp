@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include "assert.hpp"
+#include "bigint.hpp"
+#include "modular.hpp"
+#include "number_types.hpp"
+#include "dynamic_matrix.hpp"
+#include "multimodular.hpp"
+
+namespace matrices {
+
+    namespace helper {
+
+        struct dixon_impl {
+            using bigint = number_utils::bigint;
+            using ull = unsigned long long;
+
+            static bigint int128_to_bigint(__int128 x);
+
+            static void subtract_product(std::vector<bigint>& r, const std::vector<bigint>& a, const std::vector<long long>& small_a,
+                                         const std::vector<ull>& x, int n, int k);
+
+            static bool verify_solution(const std::vector<bigint>& a, const std::vector<bigint>& b,
+                                        const std::vector<bigint>& numers, const bigint& denom, int n, int k);
+
+            static std::pair<dynamic_matrix<fraction<bigint>>, bool> solve(const std::vector<bigint>& a, const std::vector<bigint>& b, int n, int k);
+        };
+
+    }
+
+    std::pair<dynamic_matrix<fraction<number_utils::bigint>>, bool> solve_dixon(const dynamic_matrix<number_utils::bigint>& a,
+                                                                                const dynamic_matrix<number_utils::bigint>& b);
+
+}
@@ -283,8 +283,7 @@ namespace matrices {
         }
 
         inline int compute_rank() {
-            dynamic_matrix<T> copy = *this;
-            return copy.compute_REF_rank_det().first;
+            return impl::compute_rank(*this);
         }
 
         int compute_RREF_and_rank() {
@@ -305,6 +304,20 @@ namespace matrices {
             return impl::compute_inverse_RREF(*this);
         }
 
+        std::pair<dynamic_matrix<T>, bool> inverse_iterative(int max_iterations = 100) const {
+            return impl::inverse_newton_schulz(*this, nullptr, max_iterations);
+        }
+
+        std::pair<dynamic_matrix<T>, bool> inverse_iterative(const dynamic_matrix<T>& initial, int max_iterations = 100) const {
+            check_dimen(initial);
+            return impl::inverse_newton_schulz(*this, &initial, max_iterations);
+        }
+
+        std::pair<dynamic_matrix<T>, bool> solve(const dynamic_matrix<T>& b) const {
+            do_assert(ROWS == b.ROWS, "Incompatible matrix dimensions for solving");
+            return impl::solve(*this, b);
+        }
+
         inline T trace() const {
             assert_square();
             T sum = elements[0];
@@ -315,9 +328,7 @@ namespace matrices {
         }
 
         inline T compute_determinant_REF() const {
-            assert_square();
-            dynamic_matrix<T> copy = *this;
-            return copy.compute_REF_rank_det().second;
+            return impl::compute_determinant(*this);
         }
     };
 
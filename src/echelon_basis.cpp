@@ -0,0 +1 @@
+#include "echelon_basis.hpp"
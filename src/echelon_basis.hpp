@@ -0,0 +1,127 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "dense_kernels.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    template <typename T>
+    class echelon_basis {
+        int n;
+        T zero;
+        std::vector<T> basis_rows;
+        std::vector<int> pivots, pivot_row;
+
+        inline T* row_at(int index) {
+            return &basis_rows[(size_t)index * n];
+        }
+
+        inline const T* row_at(int index) const {
+            return &basis_rows[(size_t)index * n];
+        }
+
+        void reduce_in_place(std::vector<T>& row) const {
+            do_assert((int)row.size() == n, "Incompatible row length for echelon basis");
+            for (int r = 0; r < rank(); r++) {
+                int p = pivots[r];
+                if (row[p] != zero) {
+                    T mult = row[p];
+                    helper::dense_kernels<T>::subtract_row(&row[p], row_at(r) + p, n - p, mult);
+                }
+            }
+        }
+
+    public:
+        explicit echelon_basis(int cols) : echelon_basis(cols, number_utils::get_zero<T>()) { }
+
+        echelon_basis(int cols, const T& sample)
+            : n(cols), zero(number_utils::get_zero<T>(sample)), pivot_row(cols, -1) {
+            do_assert(cols > 0, "Echelon basis needs at least one column");
+        }
+
+        inline int cols() const {
+            return n;
+        }
+
+        inline int rank() const {
+            return pivots.size();
+        }
+
+        inline bool is_full() const {
+            return rank() == n;
+        }
+
+        std::vector<int> pivot_columns() const {
+            std::vector<int> out = pivots;
+            std::sort(out.begin(), out.end());
+            return out;
+        }
+
+        std::vector<T> reduce(std::vector<T> row) const {
+            reduce_in_place(row);
+            return row;
+        }
+
+        bool contains(const std::vector<T>& row) const {
+            std::vector<T> rest = reduce(row);
+            return std::all_of(rest.begin(), rest.end(), [this](const T& x) { return x == zero; });
+        }
+
+        bool insert(std::vector<T> row) {
+            reduce_in_place(row);
+            int p = 0;
+            while (p < n && row[p] == zero) {
+                p++;
+            }
+            if (p == n)
+                return false;
+
+            helper::dense_kernels<T>::scale_row(&row[p], n - p, row[p]);
+            for (int r = 0; r < rank(); r++) {
+                T* other = row_at(r);
+                if (other[p] != zero) {
+                    T mult = other[p];
+                    helper::dense_kernels<T>::subtract_row(other + p, &row[p], n - p, mult);
+                }
+            }
+            basis_rows.insert(basis_rows.end(), row.begin(), row.end());
+            pivot_row[p] = pivots.size();
+            pivots.push_back(p);
+            return true;
+        }
+
+        int insert_rows(const dynamic_matrix<T>& m) {
+            do_assert(m.cols() == n, "Incompatible row length for echelon basis");
+            int added = 0;
+            std::vector<T> row(n);
+            for (int i = 0; i < m.rows() && !is_full(); i++) {
+                for (int j = 0; j < n; j++) {
+                    row[j] = m.element(i, j);
+                }
+                added += insert(row);
+            }
+            return added;
+        }
+
+        dynamic_matrix<T> basis() const {
+            do_assert(rank() > 0, "Echelon basis is empty");
+            dynamic_matrix<T> out(rank(), n, zero);
+            int i = 0;
+            for (int p = 0; p < n; p++) {
+                if (pivot_row[p] < 0)
+                    continue;
+                const T* row = row_at(pivot_row[p]);
+                for (int j = 0; j < n; j++) {
+                    out.element(i, j) = row[j];
+                }
+                i++;
+            }
+            return out;
+        }
+    };
+
+}
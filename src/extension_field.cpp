@@ -0,0 +1 @@
+#include "extension_field.hpp"
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "dense_kernels.hpp"
+
+namespace matrices {
+
+    template <int P, int K, unsigned long long POLY>
+    class extension_field {
+        static_assert(P > 1 && P < (1 << 16), "Extension field needs a prime below 2^16");
+        static_assert(K >= 1 && K <= 16, "Extension field degree must be between 1 and 16");
+
+    public:
+        typedef std::array<int, K> coefficients;
+
+    private:
+        typedef std::vector<long long> polynomial;
+
+        struct tables {
+            polynomial modulus;
+            std::vector<coefficients> reduction;
+
+            tables() : modulus(K + 1), reduction(K > 1 ? K - 1 : 0) {
+                unsigned long long poly = POLY;
+                for (int i = 0; i < K; i++, poly /= P) {
+                    modulus[i] = poly % P;
+                }
+                do_assert(poly == 0, "Polynomial coefficients must be below P");
+                modulus[K] = 1;
+                coefficients power;
+                for (int i = 0; i < K; i++) {
+                    power[i] = (P - modulus[i]) % P;
+                }
+                for (int t = 0; t < K - 1; t++) {
+                    reduction[t] = power;
+                    int top = power[K - 1];
+                    for (int i = K - 1; i > 0; i--) {
+                        power[i] = (power[i - 1] + (long long)top * (P - modulus[i])) % P;
+                    }
+                    power[0] = (long long)top * (P - modulus[0]) % P;
+                }
+            }
+        };
+
+        static inline const tables& table() {
+            static const tables t;
+            return t;
+        }
+
+        static inline long long mod(long long x) {
+            x %= P;
+            return x < 0 ? x + P : x;
+        }
+
+        static long long inverse_mod(long long a) {
+            long long out = 1;
+            for (long long e = P - 2; e > 0; e /= 2, a = a * a % P) {
+                if (e % 2)
+                    out = out * a % P;
+            }
+            return out;
+        }
+
+        static inline int degree(const polynomial& p) {
+            int d = p.size() - 1;
+            while (d >= 0 && p[d] == 0) {
+                d--;
+            }
+            return d;
+        }
+
+        coefficients c;
+
+    public:
+        inline extension_field() {
+            c.fill(0);
+        }
+
+        inline extension_field(int value) {
+            c.fill(0);
+            c[0] = mod(value);
+        }
+
+        explicit inline extension_field(const coefficients& coefs) : c(coefs) {
+            for (int& x : c) {
+                x = mod(x);
+            }
+        }
+
+        static extension_field<P, K, POLY> from_index(unsigned long long index) {
+            coefficients coefs;
+            for (int i = 0; i < K; i++, index /= P) {
+                coefs[i] = index % P;
+            }
+            return extension_field<P, K, POLY>(coefs);
+        }
+
+        inline const coefficients& value() const {
+            return c;
+        }
+
+        unsigned long long index() const {
+            unsigned long long out = 0;
+            for (int i = K - 1; i >= 0; i--) {
+                out = out * P + c[i];
+            }
+            return out;
+        }
+
+        static constexpr inline unsigned long long size() {
+            unsigned long long out = 1;
+            for (int i = 0; i < K; i++) {
+                out *= P;
+            }
+            return out;
+        }
+
+        inline bool operator==(const extension_field<P, K, POLY>& rhs) const {
+            return c == rhs.c;
+        }
+
+        inline bool operator!=(const extension_field<P, K, POLY>& rhs) const {
+            return c != rhs.c;
+        }
+
+        inline extension_field<P, K, POLY>& operator+=(const extension_field<P, K, POLY>& rhs) {
+            for (int i = 0; i < K; i++) {
+                c[i] += rhs.c[i];
+                if (c[i] >= P)
+                    c[i] -= P;
+            }
+            return *this;
+        }
+
+        inline extension_field<P, K, POLY> operator+(const extension_field<P, K, POLY>& rhs) const {
+            extension_field<P, K, POLY> out = *this;
+            return out += rhs;
+        }
+
+        inline extension_field<P, K, POLY> operator-() const {
+            extension_field<P, K, POLY> out;
+            for (int i = 0; i < K; i++) {
+                out.c[i] = c[i] ? P - c[i] : 0;
+            }
+            return out;
+        }
+
+        inline extension_field<P, K, POLY>& operator-=(const extension_field<P, K, POLY>& rhs) {
+            for (int i = 0; i < K; i++) {
+                c[i] -= rhs.c[i];
+                if (c[i] < 0)
+                    c[i] += P;
+            }
+            return *this;
+        }
+
+        inline extension_field<P, K, POLY> operator-(const extension_field<P, K, POLY>& rhs) const {
+            extension_field<P, K, POLY> out = *this;
+            return out -= rhs;
+        }
+
+        extension_field<P, K, POLY> operator*(const extension_field<P, K, POLY>& rhs) const {
+            long long product[2 * K - 1] = {};
+            for (int i = 0; i < K; i++) {
+                if (c[i] == 0)
+                    continue;
+                for (int j = 0; j < K; j++) {
+                    product[i + j] += (long long)c[i] * rhs.c[j];
+                }
+            }
+            const tables& t = table();
+            for (int s = 0; s < K - 1; s++) {
+                long long high = product[K + s] % P;
+                if (high == 0)
+                    continue;
+                for (int i = 0; i < K; i++) {
+                    product[i] += high * t.reduction[s][i];
+                }
+            }
+            extension_field<P, K, POLY> out;
+            for (int i = 0; i < K; i++) {
+                out.c[i] = product[i] % P;
+            }
+            return out;
+        }
+
+        inline extension_field<P, K, POLY>& operator*=(const extension_field<P, K, POLY>& rhs) {
+            return *this = *this * rhs;
+        }
+
+        extension_field<P, K, POLY> inverse() const {
+            polynomial r0 = table().modulus, r1(c.begin(), c.end()), s0(K + 1, 0), s1(K + 1, 0);
+            s1[0] = 1;
+            int d1 = degree(r1);
+            do_assert(d1 >= 0, "Cannot invert zero");
+            while (d1 > 0) {
+                int d0 = degree(r0);
+                long long lead = inverse_mod(r1[d1]);
+                while (d0 >= d1) {
+                    long long q = r0[d0] * lead % P;
+                    int shift = d0 - d1;
+                    for (int i = 0; i <= d1; i++) {
+                        r0[i + shift] = mod(r0[i + shift] - q * r1[i]);
+                    }
+                    for (int i = 0; i + shift <= K; i++) {
+                        s0[i + shift] = mod(s0[i + shift] - q * s1[i]);
+                    }
+                    d0 = degree(r0);
+                }
+                std::swap(r0, r1);
+                std::swap(s0, s1);
+                d1 = d0;
+                do_assert(d1 >= 0, "Polynomial is not irreducible");
+            }
+            long long scale = inverse_mod(r1[0]);
+            extension_field<P, K, POLY> out;
+            for (int i = 0; i < K; i++) {
+                out.c[i] = s1[i] * scale % P;
+            }
+            return out;
+        }
+
+        extension_field<P, K, POLY> operator^(long long power) const {
+            if (power < 0)
+                return inverse() ^ -power;
+            extension_field<P, K, POLY> out(1), base = *this;
+            for (; power > 0; power /= 2, base *= base) {
+                if (power % 2)
+                    out *= base;
+            }
+            return out;
+        }
+
+        inline extension_field<P, K, POLY>& operator^=(long long power) {
+            return *this = *this ^ power;
+        }
+
+        inline extension_field<P, K, POLY> operator/(const extension_field<P, K, POLY>& rhs) const {
+            return *this * rhs.inverse();
+        }
+
+        inline extension_field<P, K, POLY>& operator/=(const extension_field<P, K, POLY>& rhs) {
+            return *this = *this / rhs;
+        }
+    };
+
+    namespace helper {
+
+        template <int P, int K, unsigned long long POLY>
+        struct exact_field<extension_field<P, K, POLY>> {
+            static constexpr bool enabled = true;
+        };
+
+    }
+
+}
+
+namespace number_utils {
+
+    template <int P, int K, unsigned long long POLY>
+    struct standard_numbers<matrices::extension_field<P, K, POLY>> {
+        static inline matrices::extension_field<P, K, POLY> zero() {
+            return matrices::extension_field<P, K, POLY>(0);
+        }
+
+        static inline matrices::extension_field<P, K, POLY> one() {
+            return matrices::extension_field<P, K, POLY>(1);
+        }
+
+        static inline matrices::extension_field<P, K, POLY> minus_one() {
+            return matrices::extension_field<P, K, POLY>(-1);
+        }
+
+        static inline matrices::extension_field<P, K, POLY> zero(const matrices::extension_field<P, K, POLY>& sample) {
+            return matrices::extension_field<P, K, POLY>(0);
+        }
+
+        static inline matrices::extension_field<P, K, POLY> one(const matrices::extension_field<P, K, POLY>& sample) {
+            return matrices::extension_field<P, K, POLY>(1);
+        }
+
+        static inline matrices::extension_field<P, K, POLY> minus_one(const matrices::extension_field<P, K, POLY>& sample) {
+            return matrices::extension_field<P, K, POLY>(-1);
+        }
+    };
+
+}
@@ -0,0 +1,220 @@
+#include <iomanip>
+#include <algorithm>
+#include "gf2_matrix.hpp"
+
+using namespace std;
+
+namespace matrices {
+
+    gf2_matrix::gf2_matrix(int rows, int columns) : ROWS(rows), COLS(columns), WORDS((columns + word_bits - 1) / word_bits) {
+        do_assert(ROWS > 0 && COLS > 0, "Matrix size must be positive");
+        bits.assign((size_t)ROWS * WORDS, 0);
+    }
+
+    gf2_matrix::gf2_matrix(const dynamic_matrix<int_finite_field<2>>& m) : gf2_matrix(m.rows(), m.cols()) {
+        for (int i = 0; i < ROWS; i++) {
+            for (int j = 0; j < COLS; j++) {
+                if (m.element(i, j).value())
+                    row_ptr(i)[j / word_bits] |= word(1) << (j % word_bits);
+            }
+        }
+    }
+
+    gf2_matrix gf2_matrix::identity(int size) {
+        gf2_matrix out(size, size);
+        for (int i = 0; i < size; i++) {
+            out.set(i, i, true);
+        }
+        return out;
+    }
+
+    dynamic_matrix<int_finite_field<2>> gf2_matrix::to_dynamic_matrix() const {
+        dynamic_matrix<int_finite_field<2>> out(ROWS, COLS, 0);
+        for (int i = 0; i < ROWS; i++) {
+            for (int j = 0; j < COLS; j++) {
+                if (get(i, j))
+                    out.element(i, j) = 1;
+            }
+        }
+        return out;
+    }
+
+    void gf2_matrix::swap_rows(int a, int b) {
+        if (a != b)
+            swap_ranges(row_ptr(a), row_ptr(a) + WORDS, row_ptr(b));
+    }
+
+    gf2_matrix gf2_matrix::augment(const gf2_matrix& rhs) const {
+        do_assert(ROWS == rhs.ROWS, "Incompatible matrix dimensions for augmentation");
+        gf2_matrix out(ROWS, COLS + rhs.COLS);
+        for (int i = 0; i < ROWS; i++) {
+            copy(row_ptr(i), row_ptr(i) + WORDS, out.row_ptr(i));
+            for (int j = 0; j < rhs.COLS; j++) {
+                if (rhs.get(i, j))
+                    out.flip(i, COLS + j);
+            }
+        }
+        return out;
+    }
+
+    bool gf2_matrix::operator==(const gf2_matrix& rhs) const {
+        return ROWS == rhs.ROWS && COLS == rhs.COLS && bits == rhs.bits;
+    }
+
+    gf2_matrix& gf2_matrix::operator+=(const gf2_matrix& rhs) {
+        do_assert(ROWS == rhs.ROWS && COLS == rhs.COLS, "Incompatible matrix dimensions for addition");
+        xor_row(bits.data(), rhs.bits.data(), bits.size());
+        return *this;
+    }
+
+    gf2_matrix gf2_matrix::operator*(const gf2_matrix& rhs) const {
+        do_assert(COLS == rhs.ROWS, "Incompatible matrix dimensions for multiplication");
+        gf2_matrix out(ROWS, rhs.COLS);
+        int width = rhs.WORDS;
+        vector<word> table((size_t)width << table_bits);
+        for (int k0 = 0; k0 < COLS; k0 += table_bits) {
+            int k = min(table_bits, COLS - k0), shift = k0 % word_bits, index_word = k0 / word_bits;
+            word mask = (word(1) << k) - 1;
+            for (int idx = 1; idx < (1 << k); idx++) {
+                word* entry = &table[(size_t)idx * width];
+                copy(rhs.row_ptr(k0 + __builtin_ctz(idx)), rhs.row_ptr(k0 + __builtin_ctz(idx)) + width, entry);
+                xor_row(entry, &table[(size_t)(idx & (idx - 1)) * width], width);
+            }
+            for (int i = 0; i < ROWS; i++) {
+                int idx = row_ptr(i)[index_word] >> shift & mask;
+                if (idx)
+                    xor_row(out.row_ptr(i), &table[(size_t)idx * width], width);
+            }
+        }
+        return out;
+    }
+
+    gf2_matrix gf2_matrix::transpose() const {
+        gf2_matrix out(COLS, ROWS);
+        for (int i = 0; i < ROWS; i++) {
+            for (int j = 0; j < COLS; j++) {
+                if (get(i, j))
+                    out.flip(j, i);
+            }
+        }
+        return out;
+    }
+
+    vector<int> gf2_matrix::eliminate(bool reduced, int pivot_limit) {
+        vector<int> pivots;
+        vector<word> table((size_t)WORDS << table_bits);
+        auto bit = [](const word* row, int col) { return (int)(row[col / word_bits] >> (col % word_bits) & 1); };
+        int r = 0;
+        for (int c0 = 0; c0 < pivot_limit && r < ROWS; c0 += table_bits) {
+            int c1 = min(pivot_limit, c0 + table_bits), first = c0 / word_bits, width = WORDS - first;
+            vector<int> chunk;
+            for (int c = c0; c < c1 && r + (int)chunk.size() < ROWS; c++) {
+                int top = r + chunk.size();
+                for (int i = top; i < ROWS; i++) {
+                    word* row = row_ptr(i);
+                    for (int s = 0; s < (int)chunk.size(); s++) {
+                        if (bit(row, chunk[s]))
+                            xor_row(row + first, row_ptr(r + s) + first, width);
+                    }
+                    if (!bit(row, c))
+                        continue;
+                    swap_rows(i, top);
+                    for (int s = 0; s < (int)chunk.size(); s++) {
+                        if (bit(row_ptr(r + s), c))
+                            xor_row(row_ptr(r + s) + first, row_ptr(top) + first, width);
+                    }
+                    chunk.push_back(c);
+                    break;
+                }
+            }
+
+            int found = chunk.size();
+            if (found == 0)
+                continue;
+            for (int idx = 1; idx < (1 << found); idx++) {
+                word* entry = &table[(size_t)idx * width];
+                const word* pivot = row_ptr(r + __builtin_ctz(idx)) + first;
+                copy(pivot, pivot + width, entry);
+                xor_row(entry, &table[(size_t)(idx & (idx - 1)) * width], width);
+            }
+            for (int i = reduced ? 0 : r + found; i < ROWS; i++) {
+                if (i >= r && i < r + found)
+                    continue;
+                word* row = row_ptr(i);
+                int idx = 0;
+                for (int s = 0; s < found; s++) {
+                    idx |= bit(row, chunk[s]) << s;
+                }
+                if (idx)
+                    xor_row(row + first, &table[(size_t)idx * width], width);
+            }
+            pivots.insert(pivots.end(), chunk.begin(), chunk.end());
+            r += found;
+        }
+        return pivots;
+    }
+
+    int gf2_matrix::compute_RREF_and_rank() {
+        return eliminate(true, COLS).size();
+    }
+
+    gf2_matrix gf2_matrix::compute_RREF() const {
+        gf2_matrix out = *this;
+        out.compute_RREF_and_rank();
+        return out;
+    }
+
+    int gf2_matrix::compute_rank() const {
+        gf2_matrix copy = *this;
+        return copy.eliminate(false, COLS).size();
+    }
+
+    int_finite_field<2> gf2_matrix::compute_determinant() const {
+        do_assert(ROWS == COLS, "Must be a square matrix");
+        return compute_rank() == ROWS ? 1 : 0;
+    }
+
+    pair<gf2_matrix, bool> gf2_matrix::compute_inverse() const {
+        do_assert(ROWS == COLS, "Must be a square matrix");
+        gf2_matrix aug = augment(identity(ROWS)), out(ROWS, COLS);
+        if ((int)aug.eliminate(true, COLS).size() < ROWS)
+            return make_pair(out, false);
+        for (int i = 0; i < ROWS; i++) {
+            for (int j = 0; j < COLS; j++) {
+                if (aug.get(i, COLS + j))
+                    out.flip(i, j);
+            }
+        }
+        return make_pair(out, true);
+    }
+
+    pair<gf2_matrix, bool> gf2_matrix::solve(const gf2_matrix& b) const {
+        gf2_matrix aug = augment(b), out(COLS, b.COLS);
+        vector<int> pivots = aug.eliminate(true, COLS);
+        for (int i = pivots.size(); i < ROWS; i++) {
+            for (int j = 0; j < b.COLS; j++) {
+                if (aug.get(i, COLS + j))
+                    return make_pair(out, false);
+            }
+        }
+        for (int t = 0; t < (int)pivots.size(); t++) {
+            for (int j = 0; j < b.COLS; j++) {
+                if (aug.get(t, COLS + j))
+                    out.flip(pivots[t], j);
+            }
+        }
+        return make_pair(out, true);
+    }
+
+    ostream& operator<<(ostream& os, const gf2_matrix& m) {
+        for (int i = 0; i < m.rows(); i++) {
+            os << "| " << setw(3) << m.get(i, 0);
+            for (int j = 1; j < m.cols(); j++) {
+                os << ' ' << setw(3) << m.get(i, j);
+            }
+            os << " |\n";
+        }
+        return os;
+    }
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include "assert.hpp"
+#include "number_types.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    class gf2_matrix {
+        typedef std::uint64_t word;
+        static constexpr int word_bits = 64;
+        static constexpr int table_bits = 8;
+
+        int ROWS, COLS, WORDS;
+        std::vector<word> bits;
+
+        inline word* row_ptr(int row) {
+            return &bits[(size_t)row * WORDS];
+        }
+
+        inline const word* row_ptr(int row) const {
+            return &bits[(size_t)row * WORDS];
+        }
+
+        inline void check_index(int row, int col) const {
+            do_assert(row >= 0 && row < ROWS && col >= 0 && col < COLS, "Index out of bounds");
+        }
+
+        static inline void xor_row(word* dst, const word* src, int count) {
+            for (int w = 0; w < count; w++) {
+                dst[w] ^= src[w];
+            }
+        }
+
+        void swap_rows(int a, int b);
+
+        gf2_matrix augment(const gf2_matrix& rhs) const;
+
+        std::vector<int> eliminate(bool reduced, int pivot_limit);
+
+    public:
+        gf2_matrix(int rows, int columns);
+
+        explicit gf2_matrix(const dynamic_matrix<int_finite_field<2>>& m);
+
+        static gf2_matrix identity(int size);
+
+        inline std::pair<int, int> dimension() const {
+            return std::make_pair(ROWS, COLS);
+        }
+
+        inline int rows() const {
+            return ROWS;
+        }
+
+        inline int cols() const {
+            return COLS;
+        }
+
+        inline bool get(int row, int col) const {
+            check_index(row, col);
+            return row_ptr(row)[col / word_bits] >> (col % word_bits) & 1;
+        }
+
+        inline void set(int row, int col, bool value) {
+            check_index(row, col);
+            word mask = word(1) << (col % word_bits);
+            if (value)
+                row_ptr(row)[col / word_bits] |= mask;
+            else
+                row_ptr(row)[col / word_bits] &= ~mask;
+        }
+
+        inline void flip(int row, int col) {
+            check_index(row, col);
+            row_ptr(row)[col / word_bits] ^= word(1) << (col % word_bits);
+        }
+
+        dynamic_matrix<int_finite_field<2>> to_dynamic_matrix() const;
+
+        bool operator==(const gf2_matrix& rhs) const;
+
+        inline bool operator!=(const gf2_matrix& rhs) const {
+            return !(*this == rhs);
+        }
+
+        gf2_matrix& operator+=(const gf2_matrix& rhs);
+
+        inline gf2_matrix operator+(const gf2_matrix& rhs) const {
+            gf2_matrix out = *this;
+            return out += rhs;
+        }
+
+        inline gf2_matrix& operator-=(const gf2_matrix& rhs) {
+            return *this += rhs;
+        }
+
+        inline gf2_matrix operator-(const gf2_matrix& rhs) const {
+            return *this + rhs;
+        }
+
+        gf2_matrix operator*(const gf2_matrix& rhs) const;
+
+        inline gf2_matrix& operator*=(const gf2_matrix& rhs) {
+            return *this = *this * rhs;
+        }
+
+        gf2_matrix transpose() const;
+
+        int compute_RREF_and_rank();
+
+        gf2_matrix compute_RREF() const;
+
+        int compute_rank() const;
+
+        int_finite_field<2> compute_determinant() const;
+
+        std::pair<gf2_matrix, bool> compute_inverse() const;
+
+        std::pair<gf2_matrix, bool> solve(const gf2_matrix& b) const;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const gf2_matrix& m);
+
+}
@@ -0,0 +1 @@
+#include "incremental_inverse.hpp"
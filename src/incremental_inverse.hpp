@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "dynamic_matrix.hpp"
+#include "lu_decomposition.hpp"
+
+namespace matrices {
+
+    template <typename T>
+    class incremental_inverse {
+        dynamic_matrix<T> a, a_inverse;
+        int refactor_interval, pending_updates;
+
+        T zero() const {
+            return number_utils::get_zero<T>(a.element(0, 0));
+        }
+
+        T one() const {
+            return number_utils::get_one<T>(a.element(0, 0));
+        }
+
+        static std::pair<dynamic_matrix<T>, bool> invert(const dynamic_matrix<T>& m) {
+            if constexpr (std::is_floating_point<T>::value)
+                return lu_decomposition<T>(m).inverse();
+            else
+                return m.compute_inverse_RREF();
+        }
+
+        static dynamic_matrix<T> checked_inverse(const dynamic_matrix<T>& m) {
+            std::pair<dynamic_matrix<T>, bool> result = invert(m);
+            do_assert(result.second, "Cannot compute the inverse matrix - singular");
+            return result.first;
+        }
+
+    public:
+        explicit incremental_inverse(const dynamic_matrix<T>& m, int refactor_interval = 32)
+            : a(m), a_inverse(m.rows(), m.cols()), refactor_interval(refactor_interval), pending_updates(0) {
+            do_assert(m.rows() == m.cols(), "Must be a square matrix");
+            refactor();
+        }
+
+        inline const dynamic_matrix<T>& matrix() const {
+            return a;
+        }
+
+        inline const dynamic_matrix<T>& inverse() const {
+            return a_inverse;
+        }
+
+        void refactor() {
+            a_inverse = checked_inverse(a);
+            pending_updates = 0;
+        }
+
+        bool update(const dynamic_matrix<T>& u, const dynamic_matrix<T>& v) {
+            do_assert(u.rows() == a.rows() && v.rows() == a.rows() && u.cols() == v.cols(), "Incompatible matrix dimensions for update");
+            int k = u.cols();
+            dynamic_matrix<T> vt = v.transpose();
+            dynamic_matrix<T> inverse_u = a_inverse * u, vt_inverse = vt * a_inverse;
+            dynamic_matrix<T> capacitance = dynamic_matrix<T>::identity(k, a.element(0, 0)) + vt * inverse_u;
+            std::pair<dynamic_matrix<T>, bool> capacitance_inverse = invert(capacitance);
+            if (!capacitance_inverse.second)
+                return false;
+
+            dynamic_matrix<T> next = a + u * vt;
+            if (std::is_floating_point<T>::value && pending_updates + 1 >= refactor_interval) {
+                a_inverse = checked_inverse(next);
+                pending_updates = 0;
+            } else {
+                a_inverse -= (inverse_u * capacitance_inverse.first) * vt_inverse;
+                pending_updates++;
+            }
+            a = next;
+            return true;
+        }
+
+        bool update(const std::vector<T>& u, const std::vector<T>& v) {
+            int n = a.rows();
+            do_assert((int)u.size() == n && (int)v.size() == n, "Incompatible vector dimensions for update");
+            dynamic_matrix<T> um(n, 1), vm(n, 1);
+            for (int i = 0; i < n; i++) {
+                um.element(i, 0) = u[i];
+                vm.element(i, 0) = v[i];
+            }
+            return update(um, vm);
+        }
+
+        bool update_row(int row, const std::vector<T>& delta) {
+            std::vector<T> unit(a.rows(), zero());
+            unit.at(row) = one();
+            return update(unit, delta);
+        }
+
+        bool update_column(int col, const std::vector<T>& delta) {
+            std::vector<T> unit(a.rows(), zero());
+            unit.at(col) = one();
+            return update(delta, unit);
+        }
+    };
+
+}
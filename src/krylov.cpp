@@ -0,0 +1 @@
+#include "krylov.hpp"
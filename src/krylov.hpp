@@ -0,0 +1,397 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "assert.hpp"
+#include "parallel.hpp"
+#include "sparse_matrix.hpp"
+#include "dynamic_matrix.hpp"
+#include "linear_operator.hpp"
+
+namespace matrices {
+
+    namespace helper {
+
+        template <typename T>
+        struct vector_kernels {
+            static constexpr int chunk = 1 << 14;
+            static constexpr int parallel_chunks = 4;
+
+            template <typename F>
+            static void for_chunks(int n, const F& f) {
+                int chunks = (n + chunk - 1) / chunk;
+                auto run = [&](int c) {
+                    f(c, c * chunk, std::min(n, (c + 1) * chunk));
+                };
+                if (chunks < parallel_chunks) {
+                    for (int c = 0; c < chunks; c++) {
+                        run(c);
+                    }
+                } else {
+                    parallel_for(0, chunks, run);
+                }
+            }
+
+            static T dot(const std::vector<T>& a, const std::vector<T>& b) {
+                std::vector<T> partial((a.size() + chunk - 1) / chunk, 0);
+                for_chunks(a.size(), [&](int c, int begin, int end) {
+                    T sum = 0;
+                    for (int i = begin; i < end; i++) {
+                        sum += a[i] * b[i];
+                    }
+                    partial[c] = sum;
+                });
+                return std::accumulate(partial.begin(), partial.end(), T(0));
+            }
+
+            static inline T norm(const std::vector<T>& a) {
+                return std::sqrt(dot(a, a));
+            }
+
+            static void axpy(std::vector<T>& y, T alpha, const std::vector<T>& x) {
+                for_chunks(y.size(), [&](int, int begin, int end) {
+                    for (int i = begin; i < end; i++) {
+                        y[i] += alpha * x[i];
+                    }
+                });
+            }
+
+            static void xpay(std::vector<T>& y, const std::vector<T>& x, T alpha) {
+                for_chunks(y.size(), [&](int, int begin, int end) {
+                    for (int i = begin; i < end; i++) {
+                        y[i] = x[i] + alpha * y[i];
+                    }
+                });
+            }
+
+            template <typename Op>
+            static std::vector<T> residual(const Op& a, const std::vector<T>& x, const std::vector<T>& b) {
+                std::vector<T> r = apply_operator(a, x);
+                for_chunks(r.size(), [&](int, int begin, int end) {
+                    for (int i = begin; i < end; i++) {
+                        r[i] = b[i] - r[i];
+                    }
+                });
+                return r;
+            }
+        };
+
+    }
+
+    struct krylov_options {
+        int max_iterations = 1000;
+        double tolerance = 1e-10;
+        int restart = 30;
+    };
+
+    template <typename T>
+    struct krylov_result {
+        std::vector<T> x;
+        bool converged;
+        int iterations;
+        std::vector<T> residuals;
+    };
+
+    template <typename T>
+    class identity_preconditioner {
+    public:
+        inline std::vector<T> apply(const std::vector<T>& r) const {
+            return r;
+        }
+    };
+
+    template <typename T>
+    class jacobi_preconditioner {
+        std::vector<T> inverse_diagonal;
+
+        void invert() {
+            for (T& d : inverse_diagonal) {
+                do_assert(d != 0, "Jacobi preconditioner needs a non-zero diagonal");
+                d = 1 / d;
+            }
+        }
+
+    public:
+        explicit jacobi_preconditioner(const dynamic_matrix<T>& a) : inverse_diagonal(a.rows()) {
+            do_assert(a.rows() == a.cols(), "Must be a square matrix");
+            for (int i = 0; i < a.rows(); i++) {
+                inverse_diagonal[i] = a.element(i, i);
+            }
+            invert();
+        }
+
+        explicit jacobi_preconditioner(const sparse_matrix<T>& a) : inverse_diagonal(a.rows()) {
+            do_assert(a.rows() == a.cols(), "Must be a square matrix");
+            for (int i = 0; i < a.rows(); i++) {
+                inverse_diagonal[i] = a.element(i, i);
+            }
+            invert();
+        }
+
+        std::vector<T> apply(const std::vector<T>& r) const {
+            std::vector<T> z(r.size());
+            helper::vector_kernels<T>::for_chunks(r.size(), [&](int, int begin, int end) {
+                for (int i = begin; i < end; i++) {
+                    z[i] = inverse_diagonal[i] * r[i];
+                }
+            });
+            return z;
+        }
+    };
+
+    template <typename T>
+    class incomplete_cholesky {
+        int n;
+        T applied_shift;
+        std::vector<int> starts, indices;
+        std::vector<T> entries, diagonal, input_diagonal;
+
+        bool factorize(const std::vector<T>& lower, T shift) {
+            entries = lower;
+            for (int i = 0; i < n; i++) {
+                for (int p = starts[i]; p < starts[i + 1]; p++) {
+                    int k = indices[p];
+                    T sum = entries[p];
+                    for (int a = starts[i], b = starts[k]; a < p && b < starts[k + 1];) {
+                        if (indices[a] == indices[b]) {
+                            sum -= entries[a++] * entries[b++];
+                        } else if (indices[a] < indices[b]) {
+                            a++;
+                        } else {
+                            b++;
+                        }
+                    }
+                    entries[p] = sum / diagonal[k];
+                }
+                T d = input_diagonal[i] + shift;
+                for (int p = starts[i]; p < starts[i + 1]; p++) {
+                    d -= entries[p] * entries[p];
+                }
+                if (!(d > 0))
+                    return false;
+                diagonal[i] = std::sqrt(d);
+            }
+            return true;
+        }
+
+    public:
+        explicit incomplete_cholesky(const sparse_matrix<T>& a) : n(a.rows()), applied_shift(0), starts(1, 0), diagonal(a.rows()), input_diagonal(a.rows(), 0) {
+            do_assert(a.rows() == a.cols(), "Must be a square matrix");
+            std::vector<T> lower;
+            for (int i = 0; i < n; i++) {
+                for (int p = a.row_starts()[i]; p < a.row_starts()[i + 1]; p++) {
+                    int j = a.column_indices()[p];
+                    if (j < i) {
+                        indices.push_back(j);
+                        lower.push_back(a.values()[p]);
+                    } else if (j == i) {
+                        input_diagonal[i] = a.values()[p];
+                    }
+                }
+                starts.push_back(indices.size());
+            }
+            T largest = 0;
+            for (T d : input_diagonal) {
+                do_assert(d > 0, "Incomplete Cholesky needs a positive diagonal");
+                largest = std::max(largest, d);
+            }
+            for (T shift = 0; !factorize(lower, shift);) {
+                shift = shift == 0 ? largest / 1000 : 2 * shift;
+                applied_shift = shift;
+            }
+        }
+
+        explicit incomplete_cholesky(const dynamic_matrix<T>& a) : incomplete_cholesky(sparse_matrix<T>(a)) { }
+
+        inline T shift() const {
+            return applied_shift;
+        }
+
+        std::vector<T> apply(const std::vector<T>& r) const {
+            do_assert((int)r.size() == n, "Incompatible vector size for the preconditioner");
+            std::vector<T> y(r);
+            for (int i = 0; i < n; i++) {
+                T sum = y[i];
+                for (int p = starts[i]; p < starts[i + 1]; p++) {
+                    sum -= entries[p] * y[indices[p]];
+                }
+                y[i] = sum / diagonal[i];
+            }
+            for (int i = n - 1; i >= 0; i--) {
+                y[i] /= diagonal[i];
+                for (int p = starts[i]; p < starts[i + 1]; p++) {
+                    y[indices[p]] -= entries[p] * y[i];
+                }
+            }
+            return y;
+        }
+    };
+
+    template <typename T, typename Op, typename Pre = identity_preconditioner<T>>
+    krylov_result<T> conjugate_gradient(const Op& a, const std::vector<T>& b, const Pre& m = Pre(), const krylov_options& options = krylov_options(),
+                                        std::vector<T> x = {}) {
+        typedef helper::vector_kernels<T> kernels;
+        do_assert(a.rows() == a.cols() && a.rows() == (int)b.size(), "Incompatible matrix dimensions for solve");
+        if (x.empty())
+            x.assign(b.size(), 0);
+        krylov_result<T> out{ {}, false, 0, {} };
+        T b_norm = kernels::norm(b);
+        if (b_norm == 0)
+            b_norm = 1;
+        std::vector<T> r = kernels::residual(a, x, b), z = m.apply(r), p = z;
+        T rz = kernels::dot(r, z);
+        out.residuals.push_back(kernels::norm(r) / b_norm);
+        out.converged = out.residuals.back() <= options.tolerance;
+        while (!out.converged && out.iterations < options.max_iterations) {
+            std::vector<T> q = apply_operator(a, p);
+            T pq = kernels::dot(p, q);
+            if (pq == 0)
+                break;
+            T alpha = rz / pq;
+            kernels::axpy(x, alpha, p);
+            kernels::axpy(r, -alpha, q);
+            out.iterations++;
+            out.residuals.push_back(kernels::norm(r) / b_norm);
+            out.converged = out.residuals.back() <= options.tolerance;
+            z = m.apply(r);
+            T rz_next = kernels::dot(r, z);
+            kernels::xpay(p, z, rz_next / rz);
+            rz = rz_next;
+        }
+        out.x = std::move(x);
+        return out;
+    }
+
+    template <typename T, typename Op, typename Pre = identity_preconditioner<T>>
+    krylov_result<T> bicgstab(const Op& a, const std::vector<T>& b, const Pre& m = Pre(), const krylov_options& options = krylov_options(),
+                              std::vector<T> x = {}) {
+        typedef helper::vector_kernels<T> kernels;
+        do_assert(a.rows() == a.cols() && a.rows() == (int)b.size(), "Incompatible matrix dimensions for solve");
+        if (x.empty())
+            x.assign(b.size(), 0);
+        krylov_result<T> out{ {}, false, 0, {} };
+        T b_norm = kernels::norm(b);
+        if (b_norm == 0)
+            b_norm = 1;
+        std::vector<T> r = kernels::residual(a, x, b), r_hat = r, p(b.size(), 0), v(b.size(), 0);
+        T rho = 1, alpha = 1, omega = 1;
+        out.residuals.push_back(kernels::norm(r) / b_norm);
+        out.converged = out.residuals.back() <= options.tolerance;
+        while (!out.converged && out.iterations < options.max_iterations) {
+            T rho_next = kernels::dot(r_hat, r);
+            if (rho_next == 0 || omega == 0)
+                break;
+            kernels::axpy(p, -omega, v);
+            kernels::xpay(p, r, rho_next / rho * (alpha / omega));
+            rho = rho_next;
+            std::vector<T> p_hat = m.apply(p);
+            v = apply_operator(a, p_hat);
+            T rv = kernels::dot(r_hat, v);
+            if (rv == 0)
+                break;
+            alpha = rho / rv;
+            kernels::axpy(x, alpha, p_hat);
+            kernels::axpy(r, -alpha, v);
+            out.iterations++;
+            T s_norm = kernels::norm(r) / b_norm;
+            if (s_norm <= options.tolerance) {
+                out.residuals.push_back(s_norm);
+                out.converged = true;
+                break;
+            }
+            std::vector<T> s_hat = m.apply(r), t = apply_operator(a, s_hat);
+            T tt = kernels::dot(t, t);
+            omega = tt == 0 ? 0 : kernels::dot(t, r) / tt;
+            kernels::axpy(x, omega, s_hat);
+            kernels::axpy(r, -omega, t);
+            out.residuals.push_back(kernels::norm(r) / b_norm);
+            out.converged = out.residuals.back() <= options.tolerance;
+        }
+        out.x = std::move(x);
+        return out;
+    }
+
+    template <typename T, typename Op, typename Pre = identity_preconditioner<T>>
+    krylov_result<T> gmres(const Op& a, const std::vector<T>& b, const Pre& m = Pre(), const krylov_options& options = krylov_options(),
+                           std::vector<T> x = {}) {
+        typedef helper::vector_kernels<T> kernels;
+        do_assert(a.rows() == a.cols() && a.rows() == (int)b.size(), "Incompatible matrix dimensions for solve");
+        do_assert(options.restart > 0, "GMRES restart length must be positive");
+        if (x.empty())
+            x.assign(b.size(), 0);
+        krylov_result<T> out{ {}, false, 0, {} };
+        T b_norm = kernels::norm(b);
+        if (b_norm == 0)
+            b_norm = 1;
+        int restart = options.restart;
+        std::vector<std::vector<T>> basis(restart + 1);
+        std::vector<std::vector<T>> h(restart + 1, std::vector<T>(restart, 0));
+        std::vector<T> cs(restart), sn(restart), g(restart + 1);
+        std::vector<T> r = kernels::residual(a, x, b);
+        T beta = kernels::norm(r);
+        out.residuals.push_back(beta / b_norm);
+        out.converged = out.residuals.back() <= options.tolerance;
+        while (!out.converged && out.iterations < options.max_iterations) {
+            basis[0] = r;
+            for (T& v : basis[0]) {
+                v /= beta;
+            }
+            std::fill(g.begin(), g.end(), 0);
+            g[0] = beta;
+            int k = 0;
+            while (k < restart && out.iterations < options.max_iterations) {
+                std::vector<T> w = apply_operator(a, m.apply(basis[k]));
+                for (int i = 0; i <= k; i++) {
+                    h[i][k] = kernels::dot(w, basis[i]);
+                    kernels::axpy(w, -h[i][k], basis[i]);
+                }
+                h[k + 1][k] = kernels::norm(w);
+                for (int i = 0; i < k; i++) {
+                    T temp = cs[i] * h[i][k] + sn[i] * h[i + 1][k];
+                    h[i + 1][k] = -sn[i] * h[i][k] + cs[i] * h[i + 1][k];
+                    h[i][k] = temp;
+                }
+                T radius = std::hypot(h[k][k], h[k + 1][k]);
+                cs[k] = radius == 0 ? 1 : h[k][k] / radius;
+                sn[k] = radius == 0 ? 0 : h[k + 1][k] / radius;
+                T lucky = h[k + 1][k];
+                h[k][k] = radius;
+                h[k + 1][k] = 0;
+                g[k + 1] = -sn[k] * g[k];
+                g[k] *= cs[k];
+                out.iterations++;
+                out.residuals.push_back(std::abs(g[k + 1]) / b_norm);
+                k++;
+                if (out.residuals.back() <= options.tolerance || lucky == 0)
+                    break;
+                basis[k] = std::move(w);
+                for (T& v : basis[k]) {
+                    v /= lucky;
+                }
+            }
+            std::vector<T> y(k), update(b.size(), 0);
+            for (int i = k - 1; i >= 0; i--) {
+                T sum = g[i];
+                for (int j = i + 1; j < k; j++) {
+                    sum -= h[i][j] * y[j];
+                }
+                y[i] = h[i][i] == 0 ? 0 : sum / h[i][i];
+            }
+            for (int i = 0; i < k; i++) {
+                kernels::axpy(update, y[i], basis[i]);
+            }
+            kernels::axpy(x, T(1), m.apply(update));
+            r = kernels::residual(a, x, b);
+            beta = kernels::norm(r);
+            out.residuals.back() = beta / b_norm;
+            out.converged = out.residuals.back() <= options.tolerance;
+            if (beta == 0 || k == 0)
+                break;
+        }
+        out.x = std::move(x);
+        return out;
+    }
+
+}
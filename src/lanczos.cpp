@@ -0,0 +1 @@
+#include "lanczos.hpp"
@@ -0,0 +1,464 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "assert.hpp"
+#include "krylov.hpp"
+#include "linear_operator.hpp"
+
+namespace matrices {
+
+    enum class eigen_target { largest_magnitude, largest_algebraic, smallest_algebraic };
+
+    namespace helper {
+
+        template <typename T>
+        struct symmetric_eigen_impl {
+            static constexpr int max_sweeps = 64;
+
+            static void tridiagonal(std::vector<T>& d, std::vector<T>& e, std::vector<T>& z, int n, int z_rows) {
+                for (int l = 0; l < n; l++) {
+                    for (int sweep = 0; sweep < max_sweeps; sweep++) {
+                        int m = l;
+                        for (; m < n - 1; m++) {
+                            T dd = std::abs(d[m]) + std::abs(d[m + 1]);
+                            if (std::abs(e[m]) <= std::numeric_limits<T>::epsilon() * dd)
+                                break;
+                        }
+                        if (m == l)
+                            break;
+                        T g = (d[l + 1] - d[l]) / (2 * e[l]), r = std::hypot(g, T(1));
+                        g = d[m] - d[l] + e[l] / (g + (g >= 0 ? r : -r));
+                        T s = 1, c = 1, p = 0;
+                        int i = m - 1;
+                        for (; i >= l; i--) {
+                            T f = s * e[i], b = c * e[i];
+                            e[i + 1] = r = std::hypot(f, g);
+                            if (r == 0) {
+                                d[i + 1] -= p;
+                                e[m] = 0;
+                                break;
+                            }
+                            s = f / r;
+                            c = g / r;
+                            g = d[i + 1] - p;
+                            r = (d[i] - g) * s + 2 * c * b;
+                            p = s * r;
+                            d[i + 1] = g + p;
+                            g = c * r - b;
+                            for (int k = 0; k < z_rows; k++) {
+                                T zk = z[(size_t)k * n + i + 1];
+                                z[(size_t)k * n + i + 1] = s * z[(size_t)k * n + i] + c * zk;
+                                z[(size_t)k * n + i] = c * z[(size_t)k * n + i] - s * zk;
+                            }
+                        }
+                        if (r == 0 && i >= l)
+                            continue;
+                        d[l] -= p;
+                        e[l] = g;
+                        e[m] = 0;
+                    }
+                }
+            }
+
+            static std::vector<int> sorted_order(const std::vector<T>& d, int n, eigen_target target) {
+                std::vector<int> order(n);
+                std::iota(order.begin(), order.end(), 0);
+                std::sort(order.begin(), order.end(), [&](int x, int y) {
+                    if (target == eigen_target::largest_magnitude)
+                        return std::abs(d[x]) > std::abs(d[y]);
+                    return target == eigen_target::largest_algebraic ? d[x] > d[y] : d[x] < d[y];
+                });
+                return order;
+            }
+
+            static std::pair<std::vector<T>, std::vector<std::vector<T>>> sorted_pairs(const std::vector<T>& d, const std::vector<T>& z, int n,
+                                                                                       eigen_target target) {
+                std::vector<int> order = sorted_order(d, n, target);
+                std::vector<T> values(n);
+                std::vector<std::vector<T>> vectors(n, std::vector<T>(n));
+                for (int i = 0; i < n; i++) {
+                    values[i] = d[order[i]];
+                    for (int k = 0; k < n; k++) {
+                        vectors[i][k] = z[(size_t)k * n + order[i]];
+                    }
+                }
+                return std::make_pair(values, vectors);
+            }
+
+            static std::vector<T> identity(int n) {
+                std::vector<T> z((size_t)n * n, 0);
+                for (int i = 0; i < n; i++) {
+                    z[(size_t)i * n + i] = 1;
+                }
+                return z;
+            }
+
+            static std::pair<std::vector<T>, std::vector<std::vector<T>>> decompose_tridiagonal(std::vector<T> d, std::vector<T> e, int n, eigen_target target) {
+                std::vector<T> z = identity(n);
+                e.resize(n, 0);
+                tridiagonal(d, e, z, n, n);
+                return sorted_pairs(d, z, n, target);
+            }
+
+            static std::pair<std::vector<T>, std::vector<T>> tridiagonal_values(std::vector<T> d, std::vector<T> e, int n, eigen_target target) {
+                std::vector<T> z(n, 0);
+                z[n - 1] = 1;
+                e.resize(n, 0);
+                tridiagonal(d, e, z, n, 1);
+                std::vector<int> order = sorted_order(d, n, target);
+                std::vector<T> values(n), bottom(n);
+                for (int i = 0; i < n; i++) {
+                    values[i] = d[order[i]];
+                    bottom[i] = z[order[i]];
+                }
+                return std::make_pair(values, bottom);
+            }
+
+            static std::vector<T> tridiagonal_vector(const std::vector<T>& alpha, const std::vector<T>& beta, int n, T theta) {
+                std::vector<T> sub(beta.begin(), beta.begin() + n - 1), diag(n), super(sub), fill(n, 0), y(n, 1);
+                std::vector<bool> swapped(n, false);
+                T scale = 0;
+                for (int i = 0; i < n; i++) {
+                    diag[i] = alpha[i] - theta;
+                    scale = std::max(scale, std::abs(alpha[i]) + (i > 0 ? std::abs(beta[i - 1]) : 0) + (i + 1 < n ? std::abs(beta[i]) : 0));
+                }
+                for (int i = 0; i + 1 < n; i++) {
+                    if (std::abs(diag[i]) >= std::abs(sub[i])) {
+                        if (diag[i] != 0) {
+                            sub[i] /= diag[i];
+                            diag[i + 1] -= sub[i] * super[i];
+                        }
+                    } else {
+                        T factor = diag[i] / sub[i], next = diag[i + 1];
+                        diag[i] = sub[i];
+                        sub[i] = factor;
+                        diag[i + 1] = super[i] - factor * next;
+                        super[i] = next;
+                        if (i + 2 < n) {
+                            fill[i] = super[i + 1];
+                            super[i + 1] *= -factor;
+                        }
+                        swapped[i] = true;
+                    }
+                }
+                const T tiny = std::numeric_limits<T>::epsilon() * std::max(scale, std::numeric_limits<T>::min());
+                for (T& x : diag) {
+                    if (std::abs(x) < tiny)
+                        x = x < 0 ? -tiny : tiny;
+                }
+                for (int pass = 0; pass < 3; pass++) {
+                    for (int i = 0; i + 1 < n; i++) {
+                        if (swapped[i]) {
+                            T top = y[i];
+                            y[i] = y[i + 1];
+                            y[i + 1] = top - sub[i] * y[i];
+                        } else {
+                            y[i + 1] -= sub[i] * y[i];
+                        }
+                    }
+                    for (int i = n - 1; i >= 0; i--) {
+                        T sum = y[i];
+                        if (i + 1 < n)
+                            sum -= super[i] * y[i + 1];
+                        if (i + 2 < n)
+                            sum -= fill[i] * y[i + 2];
+                        y[i] = sum / diag[i];
+                    }
+                    T norm = vector_kernels<T>::norm(y);
+                    for (T& x : y) {
+                        x /= norm;
+                    }
+                }
+                return y;
+            }
+
+            static std::pair<std::vector<T>, std::vector<std::vector<T>>> decompose(std::vector<T> a, int n, eigen_target target) {
+                std::vector<T> q = identity(n), v(n), w(n);
+                for (int k = 0; k + 2 < n; k++) {
+                    T norm = 0;
+                    for (int i = k + 1; i < n; i++) {
+                        norm += a[(size_t)i * n + k] * a[(size_t)i * n + k];
+                    }
+                    norm = std::sqrt(norm);
+                    if (norm == 0)
+                        continue;
+                    T x0 = a[(size_t)(k + 1) * n + k], length = 0;
+                    std::fill(v.begin(), v.end(), 0);
+                    for (int i = k + 1; i < n; i++) {
+                        v[i] = a[(size_t)i * n + k];
+                    }
+                    v[k + 1] += x0 >= 0 ? norm : -norm;
+                    for (int i = k + 1; i < n; i++) {
+                        length += v[i] * v[i];
+                    }
+                    if (length == 0)
+                        continue;
+                    for (int i = k + 1; i < n; i++) {
+                        v[i] /= std::sqrt(length);
+                    }
+                    for (int j = 0; j < n; j++) {
+                        T sum = 0;
+                        for (int i = k + 1; i < n; i++) {
+                            sum += v[i] * a[(size_t)i * n + j];
+                        }
+                        w[j] = 2 * sum;
+                    }
+                    for (int i = k + 1; i < n; i++) {
+                        for (int j = 0; j < n; j++) {
+                            a[(size_t)i * n + j] -= v[i] * w[j];
+                        }
+                    }
+                    for (int i = 0; i < n; i++) {
+                        T sum = 0;
+                        for (int j = k + 1; j < n; j++) {
+                            sum += a[(size_t)i * n + j] * v[j];
+                        }
+                        for (int j = k + 1; j < n; j++) {
+                            a[(size_t)i * n + j] -= 2 * sum * v[j];
+                        }
+                        sum = 0;
+                        for (int j = k + 1; j < n; j++) {
+                            sum += q[(size_t)i * n + j] * v[j];
+                        }
+                        for (int j = k + 1; j < n; j++) {
+                            q[(size_t)i * n + j] -= 2 * sum * v[j];
+                        }
+                    }
+                }
+                std::vector<T> d(n), e(n, 0);
+                for (int i = 0; i < n; i++) {
+                    d[i] = a[(size_t)i * n + i];
+                    if (i + 1 < n)
+                        e[i] = a[(size_t)(i + 1) * n + i];
+                }
+                tridiagonal(d, e, q, n, n);
+                return sorted_pairs(d, q, n, target);
+            }
+
+            static std::vector<T> combine(const std::vector<std::vector<T>>& basis, const std::vector<T>& coefs, int count) {
+                std::vector<T> out(basis[0].size(), 0);
+                for (int i = 0; i < count; i++) {
+                    vector_kernels<T>::axpy(out, coefs[i], basis[i]);
+                }
+                return out;
+            }
+
+            static std::vector<T> random_unit(int n, unsigned seed) {
+                std::mt19937 gen(seed);
+                std::uniform_real_distribution<double> dist(-1, 1);
+                std::vector<T> out(n);
+                for (T& x : out) {
+                    x = dist(gen);
+                }
+                T norm = vector_kernels<T>::norm(out);
+                for (T& x : out) {
+                    x /= norm;
+                }
+                return out;
+            }
+
+            static void orthogonalize(std::vector<T>& w, const std::vector<std::vector<T>>& against, int count) {
+                for (int i = 0; i < count; i++) {
+                    vector_kernels<T>::axpy(w, -vector_kernels<T>::dot(w, against[i]), against[i]);
+                }
+            }
+        };
+
+    }
+
+    struct eigen_options {
+        int max_iterations = 1000;
+        double tolerance = 1e-10;
+        int basis_size = 0;
+        unsigned seed = 5489u;
+        eigen_target target = eigen_target::largest_magnitude;
+    };
+
+    template <typename T>
+    struct eigen_result {
+        std::vector<T> values;
+        std::vector<std::vector<T>> vectors;
+        bool converged;
+        int iterations;
+    };
+
+    template <typename T = double, typename Op>
+    eigen_result<T> power_iteration(const Op& a, const eigen_options& options = eigen_options()) {
+        typedef helper::vector_kernels<T> kernels;
+        do_assert(a.rows() == a.cols(), "Must be a square matrix");
+        do_assert(options.target == eigen_target::largest_magnitude, "Power iteration only finds the eigenvalue of largest magnitude");
+        eigen_result<T> out{ { 0 }, {}, false, 0 };
+        std::vector<T> v = helper::symmetric_eigen_impl<T>::random_unit(a.rows(), options.seed);
+        while (out.iterations < options.max_iterations) {
+            std::vector<T> w = apply_operator(a, v);
+            out.iterations++;
+            T lambda = kernels::dot(v, w), w_norm = kernels::norm(w);
+            out.values[0] = lambda;
+            if (w_norm == 0) {
+                out.converged = true;
+                break;
+            }
+            std::vector<T> r = w;
+            kernels::axpy(r, -lambda, v);
+            for (size_t i = 0; i < w.size(); i++) {
+                v[i] = w[i] / w_norm;
+            }
+            if (kernels::norm(r) <= options.tolerance * std::abs(lambda)) {
+                out.converged = true;
+                break;
+            }
+        }
+        out.vectors.push_back(v);
+        return out;
+    }
+
+    template <typename T = double, typename Op>
+    eigen_result<T> lanczos(const Op& a, int k, const eigen_options& options = eigen_options()) {
+        typedef helper::vector_kernels<T> kernels;
+        typedef helper::symmetric_eigen_impl<T> impl;
+        do_assert(a.rows() == a.cols(), "Must be a square matrix");
+        int n = a.rows(), limit = std::min(n, options.max_iterations);
+        do_assert(k > 0 && k <= n, "Number of eigenpairs must be between 1 and the matrix size");
+        const T good = std::sqrt(std::numeric_limits<T>::epsilon());
+        std::vector<std::vector<T>> basis(1, impl::random_unit(n, options.seed)), ritz;
+        std::vector<T> alpha, beta, ritz_values;
+        eigen_result<T> out{ {}, {}, false, 0 };
+        for (int j = 0; j < limit; j++) {
+            std::vector<T> w = apply_operator(a, basis[j]);
+            if (j > 0)
+                kernels::axpy(w, -beta[j - 1], basis[j - 1]);
+            alpha.push_back(kernels::dot(w, basis[j]));
+            kernels::axpy(w, -alpha[j], basis[j]);
+            beta.push_back(kernels::norm(w));
+            out.iterations = j + 1;
+
+            int m = j + 1;
+            bool last = m == limit || beta[j] == 0;
+            if (m >= k && (last || m % std::max(5, k) == 0)) {
+                std::vector<T> off(beta.begin(), beta.end() - 1);
+                std::pair<std::vector<T>, std::vector<T>> projected = impl::tridiagonal_values(alpha, off, m, options.target);
+                T norm = std::max(std::abs(projected.first.front()), std::abs(projected.first.back()));
+                int converged = 0;
+                while (converged < k && beta[j] * std::abs(projected.second[converged]) <= options.tolerance * norm) {
+                    converged++;
+                }
+                if (converged == k)
+                    last = true;
+                for (int i = 0; i < m && !last; i++) {
+                    if (beta[j] * std::abs(projected.second[i]) > good * norm)
+                        continue;
+                    bool known = false;
+                    for (T value : ritz_values) {
+                        known = known || std::abs(value - projected.first[i]) <= good * norm;
+                    }
+                    if (!known) {
+                        ritz_values.push_back(projected.first[i]);
+                        ritz.push_back(impl::combine(basis, impl::tridiagonal_vector(alpha, off, m, projected.first[i]), m));
+                    }
+                }
+                out.converged = converged == k;
+            }
+            if (last)
+                break;
+            impl::orthogonalize(w, ritz, ritz.size());
+            beta[j] = kernels::norm(w);
+            for (T& x : w) {
+                x /= beta[j];
+            }
+            basis.push_back(std::move(w));
+        }
+        int m = out.iterations;
+        std::pair<std::vector<T>, std::vector<std::vector<T>>> projected =
+            impl::decompose_tridiagonal(alpha, std::vector<T>(beta.begin(), beta.end() - 1), m, options.target);
+        if (beta[m - 1] == 0)
+            out.converged = m >= k;
+        for (int i = 0; i < std::min(k, m); i++) {
+            out.values.push_back(projected.first[i]);
+            out.vectors.push_back(impl::combine(basis, projected.second[i], m));
+        }
+        return out;
+    }
+
+    template <typename T = double, typename Op>
+    eigen_result<T> thick_restart_lanczos(const Op& a, int k, const eigen_options& options = eigen_options()) {
+        typedef helper::vector_kernels<T> kernels;
+        typedef helper::symmetric_eigen_impl<T> impl;
+        do_assert(a.rows() == a.cols(), "Must be a square matrix");
+        int n = a.rows();
+        do_assert(k > 0 && k <= n, "Number of eigenpairs must be between 1 and the matrix size");
+        int size = std::min(n, options.basis_size > 0 ? options.basis_size : std::max(2 * k + 10, 20));
+        do_assert(size > k, "Thick restart basis must be larger than the number of eigenpairs");
+        int keep = std::min(size - 1, k + (size - k) / 2);
+
+        std::vector<std::vector<T>> basis(1, impl::random_unit(n, options.seed));
+        std::vector<T> h;
+        eigen_result<T> out{ {}, {}, false, 0 };
+        int m = 0;
+        while (true) {
+            std::vector<T> w = apply_operator(a, basis[m]);
+            out.iterations++;
+            std::vector<T> column(m + 1);
+            for (int pass = 0; pass < 2; pass++) {
+                for (int i = 0; i <= m; i++) {
+                    T c = kernels::dot(w, basis[i]);
+                    column[i] += c;
+                    kernels::axpy(w, -c, basis[i]);
+                }
+            }
+            std::vector<T> grown((size_t)(m + 1) * (m + 1), 0);
+            for (int i = 0; i < m; i++) {
+                std::copy(h.begin() + (size_t)i * m, h.begin() + (size_t)(i + 1) * m, grown.begin() + (size_t)i * (m + 1));
+            }
+            for (int i = 0; i <= m; i++) {
+                grown[(size_t)i * (m + 1) + m] = grown[(size_t)m * (m + 1) + i] = column[i];
+            }
+            h = std::move(grown);
+            m++;
+            T residual = kernels::norm(w);
+            bool exhausted = out.iterations >= options.max_iterations || residual == 0 || m == n;
+            if (m < size && !exhausted) {
+                for (T& x : w) {
+                    x /= residual;
+                }
+                basis.push_back(std::move(w));
+                continue;
+            }
+
+            auto projected = impl::decompose(h, m, options.target);
+            T norm = std::max(std::abs(projected.first.front()), std::abs(projected.first.back()));
+            int converged = 0;
+            while (converged < std::min(k, m) && residual * std::abs(projected.second[converged][m - 1]) <= options.tolerance * norm) {
+                converged++;
+            }
+            if (converged >= k || exhausted) {
+                out.converged = converged >= k || (residual == 0 && m >= k);
+                for (int i = 0; i < std::min(k, m); i++) {
+                    out.values.push_back(projected.first[i]);
+                    out.vectors.push_back(impl::combine(basis, projected.second[i], m));
+                }
+                return out;
+            }
+
+            std::vector<std::vector<T>> restarted;
+            for (int i = 0; i < keep; i++) {
+                restarted.push_back(impl::combine(basis, projected.second[i], m));
+            }
+            for (T& x : w) {
+                x /= residual;
+            }
+            restarted.push_back(std::move(w));
+            basis = std::move(restarted);
+            m = keep;
+            h.assign((size_t)m * m, 0);
+            for (int i = 0; i < m; i++) {
+                h[(size_t)i * m + i] = projected.first[i];
+            }
+        }
+    }
+
+}
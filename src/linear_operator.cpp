@@ -0,0 +1 @@
+#include "linear_operator.hpp"
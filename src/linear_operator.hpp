@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "parallel.hpp"
+#include "dynamic_matrix.hpp"
+#include "sparse_matrix.hpp"
+
+namespace matrices {
+
+    namespace helper {
+
+        constexpr int operator_block_rows = 64;
+        constexpr long long operator_parallel_work = 1 << 16;
+
+        template <typename T, typename Op>
+        inline auto apply_impl(const Op& a, const std::vector<T>& x, int) -> decltype(a.apply(x)) {
+            return a.apply(x);
+        }
+
+        template <typename T, typename Op>
+        inline auto apply_impl(const Op& a, const std::vector<T>& x, long) -> decltype(a * x) {
+            return a * x;
+        }
+
+        template <typename T>
+        std::vector<T> apply_impl(const dynamic_matrix<T>& a, const std::vector<T>& x, long) {
+            do_assert((int)x.size() == a.cols(), "Incompatible matrix dimensions for multiplication");
+            std::vector<T> y(a.rows(), number_utils::get_zero<T>(a.element(0, 0)));
+            auto rows = [&](int block) {
+                for (int i = block * operator_block_rows; i < std::min(a.rows(), (block + 1) * operator_block_rows); i++) {
+                    T sum = y[i];
+                    for (int j = 0; j < a.cols(); j++) {
+                        sum += a.element(i, j) * x[j];
+                    }
+                    y[i] = sum;
+                }
+            };
+            int blocks = (a.rows() + operator_block_rows - 1) / operator_block_rows;
+            if ((long long)a.rows() * a.cols() >= operator_parallel_work) {
+                parallel_for(0, blocks, rows);
+            } else {
+                for (int block = 0; block < blocks; block++) {
+                    rows(block);
+                }
+            }
+            return y;
+        }
+
+        template <typename T, typename Op>
+        inline auto apply_transpose_impl(const Op& a, const std::vector<T>& x, int) -> decltype(a.apply_transpose(x)) {
+            return a.apply_transpose(x);
+        }
+
+        template <typename T>
+        std::vector<T> apply_transpose_impl(const dynamic_matrix<T>& a, const std::vector<T>& x, long) {
+            do_assert((int)x.size() == a.rows(), "Incompatible matrix dimensions for multiplication");
+            std::vector<T> y(a.cols(), number_utils::get_zero<T>(a.element(0, 0)));
+            for (int i = 0; i < a.rows(); i++) {
+                for (int j = 0; j < a.cols(); j++) {
+                    y[j] += a.element(i, j) * x[i];
+                }
+            }
+            return y;
+        }
+
+        template <typename T>
+        std::vector<T> apply_transpose_impl(const sparse_matrix<T>& a, const std::vector<T>& x, long) {
+            do_assert((int)x.size() == a.rows(), "Incompatible matrix dimensions for multiplication");
+            std::vector<T> y(a.cols(), number_utils::get_zero<T>(a.element(0, 0)));
+            for (int i = 0; i < a.rows(); i++) {
+                for (int k = a.row_starts()[i]; k < a.row_starts()[i + 1]; k++) {
+                    y[a.column_indices()[k]] += a.values()[k] * x[i];
+                }
+            }
+            return y;
+        }
+
+    }
+
+    template <typename T, typename Op>
+    inline std::vector<T> apply_operator(const Op& a, const std::vector<T>& x) {
+        return helper::apply_impl<T>(a, x, 0);
+    }
+
+    template <typename T, typename Op>
+    inline std::vector<T> apply_transpose_operator(const Op& a, const std::vector<T>& x) {
+        return helper::apply_transpose_impl<T>(a, x, 0);
+    }
+
+}
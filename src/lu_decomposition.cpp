@@ -0,0 +1 @@
+#include "lu_decomposition.hpp"
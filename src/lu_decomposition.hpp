@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <type_traits>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "dense_kernels.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    template <typename T>
+    class lu_decomposition {
+        int n;
+        std::vector<T> lu;
+        std::vector<int> perm;
+        int swaps;
+        bool singular;
+        T zero, one;
+
+        inline const T& at(int row, int col) const {
+            return lu[(size_t)row * n + col];
+        }
+
+        inline T& at(int row, int col) {
+            return lu[(size_t)row * n + col];
+        }
+
+        int find_pivot(int p) const {
+            if constexpr (std::is_arithmetic<T>::value) {
+                int best = p;
+                for (int i = p + 1; i < n; i++) {
+                    if (std::abs(at(i, p)) > std::abs(at(best, p)))
+                        best = i;
+                }
+                return best;
+            } else {
+                for (int i = p; i < n; i++) {
+                    if (at(i, p) != zero)
+                        return i;
+                }
+                return p;
+            }
+        }
+
+        void factorize() {
+            for (int p = 0; p < n; p++) {
+                int q = find_pivot(p);
+                if (q != p) {
+                    for (int k = 0; k < n; k++) {
+                        std::swap(at(p, k), at(q, k));
+                    }
+                    std::swap(perm[p], perm[q]);
+                    swaps++;
+                }
+                if (at(p, p) == zero) {
+                    singular = true;
+                    continue;
+                }
+                for (int i = p + 1; i < n; i++) {
+                    if (at(i, p) == zero)
+                        continue;
+                    T mult = at(i, p) / at(p, p);
+                    at(i, p) = mult;
+                    for (int k = p + 1; k < n; k++) {
+                        at(i, k) -= mult * at(p, k);
+                    }
+                }
+            }
+        }
+
+        void assert_solvable(int rows) const {
+            do_assert(rows == n, "Incompatible matrix dimensions for LU solve");
+            do_assert(!singular, "Cannot solve the system - singular");
+        }
+
+        void substitute(std::vector<T>& x, int k) const {
+            helper::dense_kernels<T>::trsm_lower(lu.data(), n, x.data(), k, n, k, true);
+            helper::dense_kernels<T>::trsm_upper(lu.data(), n, x.data(), k, n, k, false);
+        }
+
+    public:
+        explicit lu_decomposition(const dynamic_matrix<T>& m)
+            : n(m.rows()), lu((size_t)m.rows() * m.rows()), perm(m.rows()), swaps(0), singular(false),
+              zero(number_utils::get_zero<T>(m.element(0, 0))), one(number_utils::get_one<T>(m.element(0, 0))) {
+            do_assert(m.rows() == m.cols(), "Must be a square matrix");
+            for (int i = 0; i < n; i++) {
+                perm[i] = i;
+                for (int j = 0; j < n; j++) {
+                    at(i, j) = m.element(i, j);
+                }
+            }
+            factorize();
+        }
+
+        inline int size() const {
+            return n;
+        }
+
+        inline bool is_singular() const {
+            return singular;
+        }
+
+        inline const std::vector<int>& permutation() const {
+            return perm;
+        }
+
+        dynamic_matrix<T> lower() const {
+            dynamic_matrix<T> out(n, n, zero);
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < i; j++) {
+                    out.element(i, j) = at(i, j);
+                }
+                out.element(i, i) = one;
+            }
+            return out;
+        }
+
+        dynamic_matrix<T> upper() const {
+            dynamic_matrix<T> out(n, n, zero);
+            for (int i = 0; i < n; i++) {
+                for (int j = i; j < n; j++) {
+                    out.element(i, j) = at(i, j);
+                }
+            }
+            return out;
+        }
+
+        T determinant() const {
+            T det = swaps % 2 ? -one : one;
+            for (int i = 0; i < n; i++) {
+                det *= at(i, i);
+            }
+            return det;
+        }
+
+        std::vector<T> solve(const std::vector<T>& b) const {
+            assert_solvable(b.size());
+            std::vector<T> x(n);
+            for (int i = 0; i < n; i++) {
+                x[i] = b[perm[i]];
+            }
+            substitute(x, 1);
+            return x;
+        }
+
+        dynamic_matrix<T> solve(const dynamic_matrix<T>& b) const {
+            assert_solvable(b.rows());
+            int k = b.cols();
+            std::vector<T> x((size_t)n * k);
+            for (int i = 0; i < n; i++) {
+                for (int c = 0; c < k; c++) {
+                    x[(size_t)i * k + c] = b.element(perm[i], c);
+                }
+            }
+            substitute(x, k);
+            dynamic_matrix<T> out(n, k);
+            for (int i = 0; i < n; i++) {
+                for (int c = 0; c < k; c++) {
+                    out.element(i, c) = x[(size_t)i * k + c];
+                }
+            }
+            return out;
+        }
+
+        std::pair<dynamic_matrix<T>, bool> inverse() const {
+            if (singular)
+                return std::make_pair(dynamic_matrix<T>(n, n, zero), false);
+            return std::make_pair(solve(dynamic_matrix<T>::identity(n, one)), true);
+        }
+    };
+
+}
@@ -262,8 +262,7 @@ namespace matrices {
         }
 
         inline int compute_rank() {
-            matrix<T, ROWS, COLS> copy = *this;
-            return copy.compute_REF_rank_det().first;
+            return impl::compute_rank(*this);
         }
 
         int compute_RREF_and_rank() {
@@ -294,9 +293,7 @@ namespace matrices {
         }
 
         inline T compute_determinant_REF() const {
-            assert_square();
-            matrix<T, ROWS, COLS> copy = *this;
-            return copy.compute_REF_rank_det().second;
+            return impl::compute_determinant(*this);
         }
     };
 
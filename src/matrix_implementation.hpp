@@ -1,6 +1,14 @@
 #pragma once
 
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
 #include "numbers.hpp"
+#include "number_types.hpp"
+#include "dense_kernels.hpp"
+#include "tiled_elimination.hpp"
 
 namespace matrices {
 
@@ -17,13 +25,190 @@ namespace matrices {
 
     namespace helper {
 
+        template <typename T>
+        struct pluq_impl {
+            static void permute_rows(T* a, int lda, int rows, int cols, const int* perm) {
+                std::vector<T> temp((size_t)rows * cols);
+                for (int i = 0; i < rows; i++) {
+                    std::copy(a + (size_t)perm[i] * lda, a + (size_t)perm[i] * lda + cols, temp.begin() + (size_t)i * cols);
+                }
+                for (int i = 0; i < rows; i++) {
+                    std::copy(temp.begin() + (size_t)i * cols, temp.begin() + (size_t)(i + 1) * cols, a + (size_t)i * lda);
+                }
+            }
+
+            static void permute_cols(T* a, int lda, int rows, int cols, const int* perm) {
+                std::vector<T> temp(cols, a[0]);
+                for (int i = 0; i < rows; i++) {
+                    T* ai = a + (size_t)i * lda;
+                    for (int j = 0; j < cols; j++) {
+                        temp[j] = ai[perm[j]];
+                    }
+                    std::copy(temp.begin(), temp.end(), ai);
+                }
+            }
+
+            static int decompose(T* a, int lda, int rows, int cols, int* rp, int* cp) {
+                for (int i = 0; i < rows; i++) {
+                    rp[i] = i;
+                }
+                for (int j = 0; j < cols; j++) {
+                    cp[j] = j;
+                }
+                if (cols == 1) {
+                    const T zero = number_utils::get_zero<T>(a[0]);
+                    int p = 0;
+                    if constexpr (std::is_floating_point<T>::value) {
+                        for (int i = 1; i < rows; i++) {
+                            if (std::abs(a[(size_t)i * lda]) > std::abs(a[(size_t)p * lda]))
+                                p = i;
+                        }
+                        if (a[(size_t)p * lda] == zero)
+                            return 0;
+                    } else {
+                        while (p < rows && a[(size_t)p * lda] == zero) {
+                            p++;
+                        }
+                        if (p == rows)
+                            return 0;
+                    }
+                    std::swap(a[0], a[(size_t)p * lda]);
+                    std::swap(rp[0], rp[p]);
+                    T inv = number_utils::get_one<T>(a[0]) / a[0];
+                    for (int i = 1; i < rows; i++) {
+                        a[(size_t)i * lda] *= inv;
+                    }
+                    return 1;
+                }
+
+                int left = cols / 2, right = cols - left;
+                int r1 = decompose(a, lda, rows, left, rp, cp);
+                permute_rows(a + left, lda, rows, right, rp);
+                dense_kernels<T>::trsm_lower(a, lda, a + left, lda, r1, right, true);
+                dense_kernels<T>::gemm_subtract(a + (size_t)r1 * lda + left, lda, a + (size_t)r1 * lda, lda, a + left, lda, rows - r1, r1, right);
+
+                std::vector<int> rp2(rows - r1), cp2(right);
+                int r2 = rows > r1 ? decompose(a + (size_t)r1 * lda + left, lda, rows - r1, right, rp2.data(), cp2.data()) : 0;
+                if (r2 > 0) {
+                    permute_rows(a + (size_t)r1 * lda, lda, rows - r1, r1, rp2.data());
+                    permute_cols(a + left, lda, r1, right, cp2.data());
+                    std::vector<int> old(rp + r1, rp + rows);
+                    for (int i = 0; i < rows - r1; i++) {
+                        rp[r1 + i] = old[rp2[i]];
+                    }
+                    for (int j = 0; j < right; j++) {
+                        cp[left + j] = left + cp2[j];
+                    }
+                    if (r1 < left) {
+                        for (int i = 0; i < rows; i++) {
+                            T* ai = a + (size_t)i * lda;
+                            std::rotate(ai + r1, ai + left, ai + left + r2);
+                        }
+                        std::rotate(cp + r1, cp + left, cp + left + r2);
+                    }
+                }
+                return r1 + r2;
+            }
+
+            static int decompose(std::vector<T>& a, int rows, int cols, std::vector<int>& rp, std::vector<int>& cp) {
+                rp.resize(rows);
+                cp.resize(cols);
+                return decompose(a.data(), cols, rows, cols, rp.data(), cp.data());
+            }
+
+            static bool is_odd(const std::vector<int>& perm) {
+                std::vector<bool> seen(perm.size());
+                bool odd = false;
+                for (size_t i = 0; i < perm.size(); i++) {
+                    if (seen[i])
+                        continue;
+                    for (size_t j = i; !seen[j]; j = perm[j]) {
+                        seen[j] = true;
+                        if (j != i)
+                            odd = !odd;
+                    }
+                }
+                return odd;
+            }
+
+            static T determinant(std::vector<T> a, int n) {
+                std::vector<int> rp, cp;
+                if (decompose(a, n, n, rp, cp) < n)
+                    return number_utils::get_zero<T>(a[0]);
+                T det = a[0];
+                for (int i = 1; i < n; i++) {
+                    det *= a[(size_t)i * n + i];
+                }
+                return is_odd(rp) != is_odd(cp) ? -det : det;
+            }
+
+            static bool solve(std::vector<T> a, int n, std::vector<T>& b, int cols) {
+                std::vector<int> rp, cp;
+                if (decompose(a, n, n, rp, cp) < n)
+                    return false;
+                permute_rows(b.data(), cols, n, cols, rp.data());
+                dense_kernels<T>::trsm_lower(a.data(), n, b.data(), cols, n, cols, true);
+                dense_kernels<T>::trsm_upper(a.data(), n, b.data(), cols, n, cols, false);
+                std::vector<T> x(b);
+                for (int i = 0; i < n; i++) {
+                    std::copy(b.begin() + (size_t)i * cols, b.begin() + (size_t)(i + 1) * cols, x.begin() + (size_t)cp[i] * cols);
+                }
+                b.swap(x);
+                return true;
+            }
+        };
+
         template <typename T, typename M>
         struct matrix_impl {
 
+            static inline void multiply_floating_point(M& out, const M& lhs, const M& rhs) {
+                const T& sample = lhs.elements[0];
+                std::vector<double> a(lhs.rows() * lhs.cols()), b(rhs.rows() * rhs.cols()), c(lhs.rows() * rhs.cols(), 0.0);
+                for (int i = 0; i < lhs.rows(); i++) {
+                    for (int k = 0; k < lhs.cols(); k++) {
+                        a[i * lhs.cols() + k] = lhs.get_elem(i, k).value();
+                    }
+                }
+                for (int k = 0; k < rhs.rows(); k++) {
+                    for (int j = 0; j < rhs.cols(); j++) {
+                        b[k * rhs.cols() + j] = rhs.get_elem(k, j).value();
+                    }
+                }
+                multiply_mod_double(a.data(), b.data(), c.data(), lhs.rows(), lhs.cols(), rhs.cols(), floating_point_gemm<T>::modulus(sample));
+                for (int i = 0; i < lhs.rows(); i++) {
+                    for (int j = 0; j < rhs.cols(); j++) {
+                        out.get_elem(i, j) = floating_point_gemm<T>::make(sample, c[i * rhs.cols() + j]);
+                    }
+                }
+            }
+
+            static inline void multiply_rows(M& out, const M& lhs, const M& rhs) {
+                std::fill(out.elements.begin(), out.elements.end(), number_utils::get_zero<T>(lhs.elements[0]));
+                dense_kernels<T>::gemm_subtract(&out.elements[0], rhs.cols(), &lhs.elements[0], lhs.cols(), &rhs.elements[0], rhs.cols(),
+                                                lhs.rows(), lhs.cols(), rhs.cols());
+                for (T& x : out.elements) {
+                    x = -x;
+                }
+            }
+
             static inline void multiply(M& out, const M& lhs, const M& rhs) {
+                if constexpr (semiring_gemm<T>::specialized) {
+                    semiring_gemm<T>::multiply(&out.elements[0], &lhs.elements[0], &rhs.elements[0], lhs.rows(), lhs.cols(), rhs.cols());
+                    return;
+                }
+                if constexpr (row_kernel<T>::specialized) {
+                    multiply_rows(out, lhs, rhs);
+                    return;
+                }
+                if constexpr (floating_point_gemm<T>::candidate) {
+                    if (floating_point_gemm<T>::usable(lhs.elements[0])) {
+                        multiply_floating_point(out, lhs, rhs);
+                        return;
+                    }
+                }
                 for (int i = 0; i < lhs.rows(); i++) {
                     for (int j = 0; j < rhs.cols(); j++) {
-                        for (int k = 0; k < rhs.cols(); k++) {
+                        for (int k = 0; k < lhs.cols(); k++) {
                             out.get_elem(i, j) += lhs.get_elem(i, k) * rhs.get_elem(k, j);
                         }
                     }
@@ -36,6 +221,20 @@ namespace matrices {
                     lhs = lhs * rhs;
                     return;
                 }
+                if constexpr (row_kernel<T>::specialized || semiring_gemm<T>::specialized) {
+                    M out = lhs;
+                    multiply(out, lhs, rhs);
+                    lhs = out;
+                    return;
+                }
+                if constexpr (floating_point_gemm<T>::candidate) {
+                    if (floating_point_gemm<T>::usable(lhs.elements[0])) {
+                        M out = lhs;
+                        multiply_floating_point(out, lhs, rhs);
+                        lhs = out;
+                        return;
+                    }
+                }
 
                 for (int i = 0; i < lhs.rows(); i++) {
                     std::vector<T> temp(lhs.cols(), number_utils::get_zero<T>(lhs.elements[0]));
@@ -56,11 +255,25 @@ namespace matrices {
                     rhs = lhs * rhs;
                     return;
                 }
+                if constexpr (row_kernel<T>::specialized || semiring_gemm<T>::specialized) {
+                    M out = rhs;
+                    multiply(out, lhs, rhs);
+                    rhs = out;
+                    return;
+                }
+                if constexpr (floating_point_gemm<T>::candidate) {
+                    if (floating_point_gemm<T>::usable(lhs.elements[0])) {
+                        M out = rhs;
+                        multiply_floating_point(out, lhs, rhs);
+                        rhs = out;
+                        return;
+                    }
+                }
 
                 for (int j = 0; j < rhs.cols(); j++) {
                     std::vector<T> temp(rhs.rows(), number_utils::get_zero<T>(rhs.elements[0]));
                     for (int i = 0; i < rhs.rows(); i++) {
-                        for (int k = 0; k < rhs.cols(); k++) {
+                        for (int k = 0; k < rhs.rows(); k++) {
                             temp[i] += lhs.get_elem(i, k) * rhs.get_elem(k, j);
                         }
                     }
@@ -78,9 +291,13 @@ namespace matrices {
                     return lhs;
                 
                 if (power < 0) {
-                    std::pair<M, bool> RREF_inverse = lhs.compute_inverse_RREF();
-                    do_assert(RREF_inverse.second, "Cannot compute the inverse matrix - singular");
-                    return RREF_inverse.first ^ -power;
+                    if constexpr (semiring_gemm<T>::specialized) {
+                        do_assert(false, "Negative powers are not defined over a semiring");
+                    } else {
+                        std::pair<M, bool> RREF_inverse = lhs.compute_inverse_RREF();
+                        do_assert(RREF_inverse.second, "Cannot compute the inverse matrix - singular");
+                        return RREF_inverse.first ^ -power;
+                    }
                 }
                 M half = lhs ^ (power / 2);
                 half *= half;
@@ -89,117 +306,262 @@ namespace matrices {
                 return half;
             }
 
+            static inline std::vector<int> identity_order(int rows) {
+                std::vector<int> row(rows);
+                for (int i = 0; i < rows; i++) {
+                    row[i] = i;
+                }
+                return row;
+            }
+
+            static inline void apply_row_order(M& m, const std::vector<int>& row) {
+                bool moved = false;
+                for (int i = 0; i < m.rows() && !moved; i++) {
+                    moved = row[i] != i;
+                }
+                if (!moved)
+                    return;
+                std::vector<T> temp;
+                temp.reserve(m.rows() * m.cols());
+                for (int i = 0; i < m.rows(); i++) {
+                    for (int k = 0; k < m.cols(); k++) {
+                        temp.push_back(std::move(m.get_elem(row[i], k)));
+                    }
+                }
+                for (int i = 0, t = 0; i < m.rows(); i++) {
+                    for (int k = 0; k < m.cols(); k++, t++) {
+                        m.get_elem(i, k) = std::move(temp[t]);
+                    }
+                }
+            }
+
+            static inline T diagonal_product(const M& m) {
+                T det = m.elements[0];
+                for (int i = 1; i < m.rows() && i < m.cols(); i++) {
+                    det *= m.get_elem(i, i);
+                }
+                return det;
+            }
+
             static inline std::pair<int, T> compute_REF_rank_det(M& m) {
+                const T zero = number_utils::get_zero<T>(m.elements[0]);
+                std::vector<int> row = identity_order(m.rows());
                 int i, p, swaps = 0;
                 for (i = 0, p = 0; i < m.rows() && p < m.cols(); i++, p++) {
-                    while (m.get_elem(i, p) == number_utils::get_zero<T>(m.elements[0])) {
+                    while (m.get_elem(row[i], p) == zero) {
                         int j;
                         for (j = i + 1; j < m.rows(); j++) {
-                            if (m.get_elem(j, p) != number_utils::get_zero<T>(m.elements[0])) {
+                            if (m.get_elem(row[j], p) != zero) {
                                 swaps++;
-                                for (int k = p; k < m.cols(); k++) {
-                                    std::swap(m.get_elem(i, k), m.get_elem(j, k));
-                                }
+                                std::swap(row[i], row[j]);
                                 break;
                             }
                         }
                         if (j >= m.rows())
                             p++;
                         if (p >= m.cols()) {
-                            T det = m.elements[0];
-                            for (int i = 1; i < m.rows() && i < m.cols(); i++) {
-                                det *= m.get_elem(i, i);
-                            }
+                            apply_row_order(m, row);
+                            T det = diagonal_product(m);
                             return std::make_pair(i, swaps % 2 ? -det : det);
                         }
                     }
+                    const T& pivot = m.get_elem(row[i], p);
                     for (int j = i + 1; j < m.rows(); j++) {
-                        if (m.get_elem(j, p) != number_utils::get_zero<T>(m.elements[0])) {
-                            T mult = m.get_elem(j, p) / m.get_elem(i, p);
-                            for (int k = p; k < m.cols(); k++) {
-                                m.get_elem(j, k) -= mult * m.get_elem(i, k);
-                            }
+                        if (m.get_elem(row[j], p) != zero) {
+                            T mult = m.get_elem(row[j], p) / pivot;
+                            dense_kernels<T>::subtract_row(&m.get_elem(row[j], p), &pivot, m.cols() - p, mult);
                         }
                     }
                 }
-                T det = m.elements[0];
-                for (int i = 1; i < m.rows() && i < m.cols(); i++) {
-                    det *= m.get_elem(i, i);
-                }
+                apply_row_order(m, row);
+                T det = diagonal_product(m);
                 return std::make_pair(i, swaps % 2 ? -det : det);
             }
 
             static inline int compute_RREF_and_rank(M& m) {
+                const T zero = number_utils::get_zero<T>(m.elements[0]);
+                std::vector<int> row = identity_order(m.rows());
                 int i, p;
                 for (i = 0, p = 0; i < m.rows() && p < m.cols(); i++, p++) {
-                    while (m.get_elem(i, p) == number_utils::get_zero<T>(m.elements[0])) {
+                    while (m.get_elem(row[i], p) == zero) {
                         int j;
                         for (j = i + 1; j < m.rows(); j++) {
-                            if (m.get_elem(j, p) != number_utils::get_zero<T>(m.elements[0])) {
-                                for (int k = p; k < m.cols(); k++) {
-                                    std::swap(m.get_elem(i, k), m.get_elem(j, k));
-                                }
+                            if (m.get_elem(row[j], p) != zero) {
+                                std::swap(row[i], row[j]);
                                 break;
                             }
                         }
                         if (j >= m.rows())
                             p++;
-                        if (p >= m.cols())
+                        if (p >= m.cols()) {
+                            apply_row_order(m, row);
                             return i;
+                        }
                     }
                     for (int j = 0; j < m.rows(); j++) {
-                        if (j != i && m.get_elem(j, p) != number_utils::get_zero<T>(m.elements[0])) {
-                            T mult = m.get_elem(j, p) / m.get_elem(i, p);
-                            for (int k = p; k < m.cols(); k++) {
-                                m.get_elem(j, k) -= mult * m.get_elem(i, k);
-                            }
+                        if (j != i && m.get_elem(row[j], p) != zero) {
+                            T mult = m.get_elem(row[j], p) / m.get_elem(row[i], p);
+                            dense_kernels<T>::subtract_row(&m.get_elem(row[j], p), &m.get_elem(row[i], p), m.cols() - p, mult);
                         }
                     }
                     for (int k = p + 1; k < m.cols(); k++) {
-                        m.get_elem(i, k) /= m.get_elem(i, p);
+                        m.get_elem(row[i], k) /= m.get_elem(row[i], p);
                     }
-                    m.get_elem(i, p) /= m.get_elem(i, p);
+                    m.get_elem(row[i], p) /= m.get_elem(row[i], p);
                 }
+                apply_row_order(m, row);
                 return i;
             }
 
+            static inline std::vector<T> to_vector(const M& m) {
+                return std::vector<T>(m.elements.begin(), m.elements.end());
+            }
+
+            static inline int compute_rank(const M& m) {
+                if (tiled_elimination<T>::worthwhile(m.rows(), m.cols())) {
+                    std::vector<T> a = to_vector(m);
+                    return tiled_elimination<T>::rank_det(a, m.rows(), m.cols()).first;
+                }
+                if constexpr (exact_field<T>::enabled) {
+                    std::vector<T> a = to_vector(m);
+                    std::vector<int> rp, cp;
+                    return pluq_impl<T>::decompose(a, m.rows(), m.cols(), rp, cp);
+                } else {
+                    M copy = m;
+                    return compute_REF_rank_det(copy).first;
+                }
+            }
+
+            static inline T compute_determinant(const M& m) {
+                m.assert_square();
+                if (tiled_elimination<T>::worthwhile(m.rows(), m.cols())) {
+                    std::vector<T> a = to_vector(m);
+                    return tiled_elimination<T>::rank_det(a, m.rows(), m.cols()).second;
+                }
+                if constexpr (exact_field<T>::enabled) {
+                    return pluq_impl<T>::determinant(to_vector(m), m.rows());
+                } else {
+                    M copy = m;
+                    return compute_REF_rank_det(copy).second;
+                }
+            }
+
+            static inline std::pair<M, bool> solve(const M& a, const M& b) {
+                static_assert(exact_field<T>::enabled || std::is_floating_point<T>::value, "Solving needs a finite field or floating-point element type");
+                a.assert_square();
+                std::vector<T> x = to_vector(b);
+                bool regular = pluq_impl<T>::solve(to_vector(a), a.rows(), x, b.cols());
+                M out = b;
+                std::copy(x.begin(), x.end(), out.elements.begin());
+                return std::make_pair(out, regular);
+            }
+
+            static inline std::pair<M, bool> inverse_newton_schulz(const M& m, const M* initial, int max_iterations) {
+                static_assert(std::is_floating_point<T>::value, "Newton-Schulz iteration needs a floating-point type");
+                m.assert_square();
+                int n = m.rows();
+                std::vector<T> a = to_vector(m), x, r((size_t)n * n);
+                auto residual = [&]() {
+                    std::fill(r.begin(), r.end(), T(0));
+                    for (int i = 0; i < n; i++) {
+                        r[(size_t)i * n + i] = 1;
+                    }
+                    dense_kernels<T>::parallel_gemm_subtract(r.data(), n, a.data(), n, x.data(), n, n, n, n);
+                    T norm = 0;
+                    for (int i = 0; i < n; i++) {
+                        T sum = 0;
+                        for (int j = 0; j < n; j++) {
+                            sum += std::abs(r[(size_t)i * n + j]);
+                        }
+                        norm = std::max(norm, sum);
+                    }
+                    return norm;
+                };
+
+                T norm = 1;
+                if (initial != nullptr) {
+                    x = to_vector(*initial);
+                    norm = residual();
+                }
+                if (!(norm < 1)) {
+                    std::vector<T> row_sums(n, 0), col_sums(n, 0);
+                    for (int i = 0; i < n; i++) {
+                        for (int j = 0; j < n; j++) {
+                            row_sums[i] += std::abs(a[(size_t)i * n + j]);
+                            col_sums[j] += std::abs(a[(size_t)i * n + j]);
+                        }
+                    }
+                    T scale = *std::max_element(row_sums.begin(), row_sums.end()) * *std::max_element(col_sums.begin(), col_sums.end());
+                    if (scale == 0)
+                        return std::make_pair(m, false);
+                    x.assign((size_t)n * n, 0);
+                    for (int i = 0; i < n; i++) {
+                        for (int j = 0; j < n; j++) {
+                            x[(size_t)j * n + i] = a[(size_t)i * n + j] / scale;
+                        }
+                    }
+                    norm = residual();
+                }
+
+                const T eps = std::numeric_limits<T>::epsilon();
+                for (int it = 0; it < max_iterations && norm > n * eps; it++) {
+                    for (T& e : r) {
+                        e = -e;
+                    }
+                    std::vector<T> next = x;
+                    dense_kernels<T>::parallel_gemm_subtract(next.data(), n, x.data(), n, r.data(), n, n, n, n);
+                    x.swap(next);
+                    T previous = norm;
+                    norm = residual();
+                    if (!std::isfinite(norm) || (norm < std::sqrt(eps) && !(norm < previous)))
+                        break;
+                }
+                M out = m;
+                std::copy(x.begin(), x.end(), out.elements.begin());
+                return std::make_pair(out, norm < std::sqrt(eps));
+            }
+
             static inline std::pair<M, bool> compute_inverse_RREF(const M& m) {
                 m.assert_square();
+                if constexpr (exact_field<T>::enabled) {
+                    return solve(m, M::identity(m.rows(), m.elements[0]));
+                }
+                const T zero = number_utils::get_zero<T>(m.elements[0]);
                 M copy = m, inverse = M::identity(m.rows(), m.elements[0]);
+                std::vector<int> row = identity_order(m.rows());
                 int i, p;
                 for (i = 0, p = 0; i < m.rows() && p < m.cols(); i++, p++) {
-                    while (copy.get_elem(i, p) == number_utils::get_zero<T>(m.elements[0])) {
+                    while (copy.get_elem(row[i], p) == zero) {
                         int j;
                         for (j = i + 1; j < m.rows(); j++) {
-                            if (copy.get_elem(j, p) != number_utils::get_zero<T>(m.elements[0])) {
-                                for (int k = p; k < m.cols(); k++) {
-                                    std::swap(copy.get_elem(i, k), copy.get_elem(j, k));
-                                    std::swap(inverse.get_elem(i, k), inverse.get_elem(j, k));
-                                }
+                            if (copy.get_elem(row[j], p) != zero) {
+                                std::swap(row[i], row[j]);
                                 break;
                             }
                         }
                         if (j >= m.rows())
                             p++;
-                        if (p >= m.cols())
+                        if (p >= m.cols()) {
+                            apply_row_order(inverse, row);
                             return std::make_pair(inverse, false);
+                        }
                     }
                     for (int j = 0; j < m.rows(); j++) {
-                        if (j != i && copy.get_elem(j, p) != number_utils::get_zero<T>(m.elements[0])) {
-                            T mult = copy.get_elem(j, p) / copy.get_elem(i, p);
-                            for (int k = p; k < m.cols(); k++) {
-                                copy.get_elem(j, k) -= mult * copy.get_elem(i, k);
-                                inverse.get_elem(j, k) -= mult * inverse.get_elem(i, k);
-                            }
+                        if (j != i && copy.get_elem(row[j], p) != zero) {
+                            T mult = copy.get_elem(row[j], p) / copy.get_elem(row[i], p);
+                            dense_kernels<T>::subtract_row(&copy.get_elem(row[j], p), &copy.get_elem(row[i], p), m.cols() - p, mult);
+                            dense_kernels<T>::subtract_row(&inverse.get_elem(row[j], 0), &inverse.get_elem(row[i], 0), m.cols(), mult);
                         }
                     }
+                    for (int k = 0; k < m.cols(); k++) {
+                        inverse.get_elem(row[i], k) /= copy.get_elem(row[i], p);
+                    }
                     for (int k = p + 1; k < m.cols(); k++) {
-                        copy.get_elem(i, k) /= copy.get_elem(i, p);
-                        inverse.get_elem(i, k) /= inverse.get_elem(i, p);
+                        copy.get_elem(row[i], k) /= copy.get_elem(row[i], p);
                     }
-                    copy.get_elem(i, p) /= copy.get_elem(i, p);
-                    inverse.get_elem(i, p) /= inverse.get_elem(i, p);
+                    copy.get_elem(row[i], p) /= copy.get_elem(row[i], p);
                 }
+                apply_row_order(inverse, row);
                 return std::make_pair(inverse, i == m.rows());
             }
 
@@ -0,0 +1,120 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "mixed_precision.hpp"
+
+using namespace std;
+
+namespace matrices {
+
+    dynamic_matrix<float> mixed_precision_solver::to_float(const dynamic_matrix<double>& m) {
+        dynamic_matrix<float> out(m.rows(), m.cols());
+        for (int i = 0; i < m.rows(); i++) {
+            for (int j = 0; j < m.cols(); j++) {
+                out.element(i, j) = m.element(i, j);
+            }
+        }
+        return out;
+    }
+
+    mixed_precision_solver::mixed_precision_solver(const dynamic_matrix<double>& m, int max_iterations)
+        : n(m.rows()), a((size_t)m.rows() * m.cols()), a_norm(0), low(to_float(m)),
+          max_iterations(max_iterations), iterations(0), fallback(false) {
+        do_assert(m.rows() == m.cols(), "Must be a square matrix");
+        for (int i = 0; i < n; i++) {
+            double row_sum = 0;
+            for (int j = 0; j < n; j++) {
+                a[(size_t)i * n + j] = m.element(i, j);
+                row_sum += abs(m.element(i, j));
+            }
+            a_norm = max(a_norm, row_sum);
+        }
+    }
+
+    vector<double> mixed_precision_solver::refine(const vector<double>& b, int cols) {
+        iterations = 0;
+        fallback = false;
+        if (!low.is_singular()) {
+            const double tolerance = sqrt((double)n) * numeric_limits<double>::epsilon() * a_norm;
+            vector<double> x((size_t)n * cols, 0), r = b;
+            double previous = numeric_limits<double>::infinity();
+            while (iterations < max_iterations) {
+                dynamic_matrix<float> rf(n, cols);
+                for (int i = 0; i < n; i++) {
+                    for (int j = 0; j < cols; j++) {
+                        rf.element(i, j) = r[(size_t)i * cols + j];
+                    }
+                }
+                dynamic_matrix<float> d = low.solve(rf);
+                for (int i = 0; i < n; i++) {
+                    for (int j = 0; j < cols; j++) {
+                        x[(size_t)i * cols + j] += d.element(i, j);
+                    }
+                }
+                iterations++;
+
+                r = b;
+                helper::dense_kernels<double>::gemm_subtract(r.data(), cols, a.data(), n, x.data(), cols, n, n, cols);
+                double r_norm = 0, x_norm = 0;
+                for (size_t i = 0; i < r.size(); i++) {
+                    r_norm = max(r_norm, abs(r[i]));
+                    x_norm = max(x_norm, abs(x[i]));
+                }
+                if (!isfinite(r_norm) || r_norm > previous / 2)
+                    break;
+                if (r_norm <= tolerance * x_norm)
+                    return x;
+                previous = r_norm;
+            }
+        }
+
+        fallback = true;
+        if (!high) {
+            dynamic_matrix<double> m(n, n);
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    m.element(i, j) = a[(size_t)i * n + j];
+                }
+            }
+            high.reset(new lu_decomposition<double>(m));
+        }
+        dynamic_matrix<double> bm(n, cols);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < cols; j++) {
+                bm.element(i, j) = b[(size_t)i * cols + j];
+            }
+        }
+        dynamic_matrix<double> xm = high->solve(bm);
+        vector<double> x((size_t)n * cols);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < cols; j++) {
+                x[(size_t)i * cols + j] = xm.element(i, j);
+            }
+        }
+        return x;
+    }
+
+    dynamic_matrix<double> mixed_precision_solver::solve(const dynamic_matrix<double>& b) {
+        do_assert(b.rows() == n, "Incompatible matrix dimensions for solving");
+        vector<double> flat((size_t)n * b.cols());
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < b.cols(); j++) {
+                flat[(size_t)i * b.cols() + j] = b.element(i, j);
+            }
+        }
+        vector<double> x = refine(flat, b.cols());
+        dynamic_matrix<double> out(n, b.cols());
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < b.cols(); j++) {
+                out.element(i, j) = x[(size_t)i * b.cols() + j];
+            }
+        }
+        return out;
+    }
+
+    vector<double> mixed_precision_solver::solve(const vector<double>& b) {
+        do_assert((int)b.size() == n, "Incompatible matrix dimensions for solving");
+        return refine(b, 1);
+    }
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "assert.hpp"
+#include "dynamic_matrix.hpp"
+#include "lu_decomposition.hpp"
+
+namespace matrices {
+
+    class mixed_precision_solver {
+        int n;
+        std::vector<double> a;
+        double a_norm;
+        lu_decomposition<float> low;
+        std::unique_ptr<lu_decomposition<double>> high;
+        int max_iterations, iterations;
+        bool fallback;
+
+        static dynamic_matrix<float> to_float(const dynamic_matrix<double>& m);
+
+        std::vector<double> refine(const std::vector<double>& b, int cols);
+
+    public:
+        explicit mixed_precision_solver(const dynamic_matrix<double>& m, int max_iterations = 30);
+
+        dynamic_matrix<double> solve(const dynamic_matrix<double>& b);
+
+        std::vector<double> solve(const std::vector<double>& b);
+
+        inline int last_iterations() const {
+            return iterations;
+        }
+
+        inline bool used_fallback() const {
+            return fallback;
+        }
+    };
+
+}
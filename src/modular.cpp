@@ -0,0 +1,62 @@
+#include "modular.hpp"
+
+using namespace std;
+typedef unsigned long long ull;
+
+namespace number_utils {
+
+    bool is_word_prime(ull n) {
+        if (n < 2) return false;
+        for (ull p : { 2ULL, 3ULL, 5ULL, 7ULL, 11ULL, 13ULL }) {
+            if (n % p == 0) return n == p;
+        }
+        ull d = n - 1;
+        int s = 0;
+        while (d % 2 == 0) {
+            d /= 2;
+            s++;
+        }
+        for (ull a : { 2ULL, 7ULL, 61ULL }) {
+            ull x = pow_mod(a, d, n);
+            if (x == 0 || x == 1 || x == n - 1) continue;
+            bool composite = true;
+            for (int r = 1; r < s && composite; r++) {
+                x = mul_mod(x, x, n);
+                composite = x != n - 1;
+            }
+            if (composite) return false;
+        }
+        return true;
+    }
+
+    vector<ull> primes_below(ull bound, int count) {
+        assert(bound <= WORD_PRIME_BOUND);
+        vector<ull> primes;
+        for (ull n = bound - 1; n > 2 && (int)primes.size() < count; n--) {
+            if (is_word_prime(n)) primes.push_back(n);
+        }
+        return primes;
+    }
+
+    pair<pair<bigint, bigint>, bool> rational_reconstruction(const bigint& u, const bigint& modulus) {
+        bigint r0 = modulus, r1 = u % modulus, t0 = 0, t1 = 1;
+        if (r1.is_negative()) r1 += modulus;
+        while (r1 * r1 * bigint(2) > modulus) {
+            bigint q, r;
+            tie(q, r) = r0.integer_divide(r1);
+            r0.swap_with(r1);
+            r1.swap_with(r);
+            bigint t = t0 - q * t1;
+            t0.swap_with(t1);
+            t1.swap_with(t);
+        }
+        if (t1.is_zero() || t1 * t1 * bigint(2) > modulus || !gcd(r1, t1).is_one()) {
+            return make_pair(make_pair(bigint(0), bigint(1)), false);
+        }
+        if (t1.is_negative()) {
+            return make_pair(make_pair(-r1, -t1), true);
+        }
+        return make_pair(make_pair(r1, t1), true);
+    }
+
+}
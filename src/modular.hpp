@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include <tuple>
+#include "numbers.hpp"
+#include "bigint.hpp"
+
+namespace number_utils {
+
+    constexpr unsigned long long WORD_PRIME_BOUND = 1ULL << 31;
+
+    constexpr inline unsigned long long mul_mod(unsigned long long a, unsigned long long b, unsigned long long m) {
+        return a * b % m;
+    }
+
+    constexpr inline unsigned long long pow_mod(unsigned long long x, unsigned long long e, unsigned long long m) {
+        unsigned long long res = 1 % m;
+        x %= m;
+        while (e > 0) {
+            if (e % 2 == 1) res = mul_mod(res, x, m);
+            x = mul_mod(x, x, m);
+            e /= 2;
+        }
+        return res;
+    }
+
+    constexpr inline unsigned long long inverse_mod(unsigned long long x, unsigned long long p) {
+        return pow_mod(x, p - 2, p);
+    }
+
+    bool is_word_prime(unsigned long long n);
+
+    std::vector<unsigned long long> primes_below(unsigned long long bound, int count);
+
+    inline void crt_combine(bigint& x, const bigint& modulus, unsigned long long modulus_inverse, unsigned long long residue, unsigned long long p) {
+        unsigned long long t = mul_mod((residue + p - x.mod_small(p)) % p, modulus_inverse, p);
+        if (t != 0) {
+            x += modulus * bigint(t);
+        }
+    }
+
+    std::pair<std::pair<bigint, bigint>, bool> rational_reconstruction(const bigint& u, const bigint& modulus);
+
+}
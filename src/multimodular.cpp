@@ -0,0 +1,281 @@
+#include <cmath>
+#include "multimodular.hpp"
+
+using namespace std;
+using namespace number_utils;
+typedef unsigned long long ull;
+
+namespace matrices {
+
+    namespace helper {
+
+        double multimodular_impl::hadamard_bound_bits(const vector<bigint>& a, int n) {
+            double bits = 0;
+            for (int i = 0; i < n; i++) {
+                size_t row_bits = 0;
+                for (int j = 0; j < n; j++) {
+                    row_bits = max(row_bits, a[i * n + j].bit_length());
+                }
+                if (row_bits == 0)
+                    return -1;
+                bits += row_bits + 0.5 * log2(n);
+            }
+            return bits;
+        }
+
+        bool multimodular_impl::inverse_mod_p(const vector<bigint>& a, int n, ull p, vector<ull>& out) {
+            dynamic_matrix<finite_field<long long>> m(n, n, finite_field<long long>(p, 0));
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    m[i][j] = finite_field<long long>(p, a[i * n + j].mod_small(p));
+                }
+            }
+            pair<dynamic_matrix<finite_field<long long>>, bool> inverse = m.compute_inverse_RREF();
+            if (!inverse.second)
+                return false;
+            out.resize(n * n);
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    out[i * n + j] = inverse.first[i][j].value();
+                }
+            }
+            return true;
+        }
+
+        bool multimodular_impl::reconstruct(const vector<bigint>& residues, const bigint& modulus,
+                                            vector<bigint>& numers, bigint& denom) {
+            int count = residues.size();
+            vector<bigint> scales(count);
+            numers.resize(count);
+            denom = 1;
+            for (int e = 0; e < count; e++) {
+                pair<pair<bigint, bigint>, bool> r = rational_reconstruction(residues[e] * denom % modulus, modulus);
+                if (!r.second)
+                    return false;
+                numers[e] = r.first.first;
+                scales[e] = r.first.second * denom;
+                denom *= r.first.second;
+            }
+            for (int e = 0; e < count; e++) {
+                if (scales[e] != denom)
+                    numers[e] *= denom / scales[e];
+            }
+            return true;
+        }
+
+        bool multimodular_impl::verify_inverse(const vector<bigint>& a, const vector<bigint>& numers, const bigint& denom, int n) {
+            for (int round = 0; round < 2; round++) {
+                vector<bigint> v(n), nv(n, bigint(0));
+                for (int i = 0; i < n; i++) {
+                    v[i] = bigint((ull)get_random<unsigned int>(1U << 20));
+                }
+                for (int i = 0; i < n; i++) {
+                    for (int j = 0; j < n; j++) {
+                        nv[i] += numers[i * n + j] * v[j];
+                    }
+                }
+                for (int i = 0; i < n; i++) {
+                    bigint sum = 0;
+                    for (int j = 0; j < n; j++) {
+                        sum += a[i * n + j] * nv[j];
+                    }
+                    if (sum != denom * v[i])
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        pair<dynamic_matrix<fraction<bigint>>, bool> multimodular_impl::inverse(const vector<bigint>& a, int n) {
+            dynamic_matrix<fraction<bigint>> out(n, n, fraction<bigint>(bigint(0)));
+            double hadamard = hadamard_bound_bits(a, n);
+            if (hadamard < 0)
+                return make_pair(out, false);
+
+            vector<bigint> residues(n * n, bigint(0));
+            bigint modulus = 1;
+            double modulus_bits = 0, bad_bits = 0;
+            ull next_bound = WORD_PRIME_BOUND;
+            int batch = max(2, thread_count());
+
+            while (true) {
+                vector<ull> primes = primes_below(next_bound, batch);
+                do_assert(!primes.empty(), "Ran out of word-size primes");
+                next_bound = primes.back();
+
+                vector<vector<ull>> inverses(primes.size());
+                vector<char> invertible(primes.size());
+                parallel_for(0, primes.size(), [&](int t) {
+                    invertible[t] = inverse_mod_p(a, n, primes[t], inverses[t]);
+                });
+
+                bool progress = false;
+                for (size_t t = 0; t < primes.size(); t++) {
+                    ull p = primes[t];
+                    if (!invertible[t]) {
+                        bad_bits += log2(p);
+                        if (bad_bits > hadamard)
+                            return make_pair(out, false);
+                        continue;
+                    }
+                    ull modulus_inverse = inverse_mod(modulus.mod_small(p), p);
+                    for (int e = 0; e < n * n; e++) {
+                        crt_combine(residues[e], modulus, modulus_inverse, inverses[t][e], p);
+                    }
+                    modulus *= bigint(p);
+                    modulus_bits += log2(p);
+                    progress = true;
+                }
+
+                vector<bigint> numers;
+                bigint denom;
+                if (progress && rational_reconstruction(residues[n * n - 1], modulus).second &&
+                    reconstruct(residues, modulus, numers, denom) && verify_inverse(a, numers, denom, n)) {
+                    for (int i = 0; i < n; i++) {
+                        for (int j = 0; j < n; j++) {
+                            out[i][j] = fraction<bigint>(numers[i * n + j], denom);
+                        }
+                    }
+                    return make_pair(out, true);
+                }
+                do_assert(modulus_bits <= 2 * hadamard + 64, "Multimodular inverse failed to converge");
+                batch *= 2;
+            }
+        }
+
+        void multimodular_impl::multiply_mod_p(const vector<ull>& a, const vector<ull>& b, vector<ull>& out,
+                                               int rows, int inner, int cols, ull p) {
+            int chunk = max(1ULL, (~0ULL - p) / ((p - 1) * (p - 1)));
+            out.assign(rows * cols, 0);
+            for (int i = 0; i < rows; i++) {
+                ull* acc = &out[i * cols];
+                for (int k0 = 0; k0 < inner; k0 += chunk) {
+                    int k1 = min(inner, k0 + chunk);
+                    for (int k = k0; k < k1; k++) {
+                        ull x = a[i * inner + k];
+                        if (x == 0)
+                            continue;
+                        const ull* row = &b[k * cols];
+                        for (int j = 0; j < cols; j++) {
+                            acc[j] += x * row[j];
+                        }
+                    }
+                    for (int j = 0; j < cols; j++) {
+                        acc[j] %= p;
+                    }
+                }
+            }
+        }
+
+        dynamic_matrix<bigint> multimodular_impl::multiply(const dynamic_matrix<bigint>& lhs, const dynamic_matrix<bigint>& rhs) {
+            do_assert(lhs.cols() == rhs.rows(), "Incompatible matrix dimensions for multiplication");
+            int rows = lhs.rows(), inner = lhs.cols(), cols = rhs.cols();
+            vector<bigint> a(rows * inner), b(inner * cols);
+            size_t a_bits = 0, b_bits = 0;
+            for (int i = 0; i < rows; i++) {
+                for (int k = 0; k < inner; k++) {
+                    a[i * inner + k] = lhs.element(i, k);
+                    a_bits = max(a_bits, a[i * inner + k].bit_length());
+                }
+            }
+            for (int k = 0; k < inner; k++) {
+                for (int j = 0; j < cols; j++) {
+                    b[k * cols + j] = rhs.element(k, j);
+                    b_bits = max(b_bits, b[k * cols + j].bit_length());
+                }
+            }
+
+            dynamic_matrix<bigint> out(rows, cols, bigint(0));
+            if (a_bits == 0 || b_bits == 0)
+                return out;
+
+            double bound_bits = a_bits + b_bits + log2(inner) + 2;
+            vector<ull> primes;
+            double modulus_bits = 0;
+            for (ull p : primes_below(WORD_PRIME_BOUND, bound_bits / 30 + 2)) {
+                if (modulus_bits >= bound_bits)
+                    break;
+                primes.push_back(p);
+                modulus_bits += log2(p);
+            }
+            do_assert(modulus_bits >= bound_bits, "Ran out of word-size primes");
+
+            vector<vector<ull>> products(primes.size());
+            parallel_for(0, primes.size(), [&](int t) {
+                ull p = primes[t];
+                vector<ull> ra(a.size()), rb(b.size());
+                for (size_t e = 0; e < a.size(); e++) {
+                    ra[e] = a[e].mod_small(p);
+                }
+                for (size_t e = 0; e < b.size(); e++) {
+                    rb[e] = b[e].mod_small(p);
+                }
+                multiply_mod_p(ra, rb, products[t], rows, inner, cols, p);
+            });
+
+            vector<bigint> moduli(primes.size());
+            vector<ull> modulus_inverses(primes.size());
+            bigint modulus = 1;
+            for (size_t t = 0; t < primes.size(); t++) {
+                moduli[t] = modulus;
+                modulus_inverses[t] = inverse_mod(modulus.mod_small(primes[t]), primes[t]);
+                modulus *= bigint(primes[t]);
+            }
+            bigint half = modulus >> 1;
+
+            parallel_for(0, rows, [&](int i) {
+                for (int j = 0; j < cols; j++) {
+                    bigint x = 0;
+                    for (size_t t = 0; t < primes.size(); t++) {
+                        crt_combine(x, moduli[t], modulus_inverses[t], products[t][i * cols + j], primes[t]);
+                    }
+                    if (x > half)
+                        x -= modulus;
+                    out[i][j] = x;
+                }
+            });
+            return out;
+        }
+
+    }
+
+    pair<dynamic_matrix<fraction<bigint>>, bool> compute_inverse_multimodular(const dynamic_matrix<bigint>& m) {
+        do_assert(m.rows() == m.cols(), "Must be a square matrix");
+        int n = m.rows();
+        vector<bigint> a(n * n);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                a[i * n + j] = m.element(i, j);
+            }
+        }
+        return helper::multimodular_impl::inverse(a, n);
+    }
+
+    pair<dynamic_matrix<fraction<bigint>>, bool> compute_inverse_multimodular(const dynamic_matrix<fraction<bigint>>& m) {
+        do_assert(m.rows() == m.cols(), "Must be a square matrix");
+        int n = m.rows();
+        vector<bigint> a(n * n), row_scale(n, bigint(1));
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                row_scale[i] = lcm(row_scale[i], m.element(i, j).denominator());
+            }
+            for (int j = 0; j < n; j++) {
+                a[i * n + j] = m.element(i, j).numerator() * (row_scale[i] / m.element(i, j).denominator());
+            }
+        }
+        pair<dynamic_matrix<fraction<bigint>>, bool> inverse = helper::multimodular_impl::inverse(a, n);
+        if (inverse.second) {
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    inverse.first[i][j] *= fraction<bigint>(row_scale[j]);
+                }
+            }
+        }
+        return inverse;
+    }
+
+    dynamic_matrix<bigint> multiply_multimodular(const dynamic_matrix<bigint>& lhs, const dynamic_matrix<bigint>& rhs) {
+        return helper::multimodular_impl::multiply(lhs, rhs);
+    }
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include "assert.hpp"
+#include "bigint.hpp"
+#include "modular.hpp"
+#include "parallel.hpp"
+#include "number_types.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    namespace helper {
+
+        struct multimodular_impl {
+            using bigint = number_utils::bigint;
+            using ull = unsigned long long;
+
+            static double hadamard_bound_bits(const std::vector<bigint>& a, int n);
+
+            static bool inverse_mod_p(const std::vector<bigint>& a, int n, ull p, std::vector<ull>& out);
+
+            static bool reconstruct(const std::vector<bigint>& residues, const bigint& modulus,
+                                    std::vector<bigint>& numers, bigint& denom);
+
+            static bool verify_inverse(const std::vector<bigint>& a, const std::vector<bigint>& numers, const bigint& denom, int n);
+
+            static std::pair<dynamic_matrix<fraction<bigint>>, bool> inverse(const std::vector<bigint>& a, int n);
+
+            static void multiply_mod_p(const std::vector<ull>& a, const std::vector<ull>& b, std::vector<ull>& out,
+                                       int rows, int inner, int cols, ull p);
+
+            static dynamic_matrix<bigint> multiply(const dynamic_matrix<bigint>& lhs, const dynamic_matrix<bigint>& rhs);
+        };
+
+    }
+
+    std::pair<dynamic_matrix<fraction<number_utils::bigint>>, bool> compute_inverse_multimodular(const dynamic_matrix<number_utils::bigint>& m);
+
+    std::pair<dynamic_matrix<fraction<number_utils::bigint>>, bool> compute_inverse_multimodular(const dynamic_matrix<fraction<number_utils::bigint>>& m);
+
+    dynamic_matrix<number_utils::bigint> multiply_multimodular(const dynamic_matrix<number_utils::bigint>& lhs, const dynamic_matrix<number_utils::bigint>& rhs);
+
+}
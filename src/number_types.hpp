@@ -221,7 +221,7 @@ namespace matrices {
         }
     };
 
-    finite_field<unsigned long long> operator ""_Zp(unsigned long long x) {
+    inline finite_field<unsigned long long> operator ""_Zp(unsigned long long x) {
         return finite_field<unsigned long long>(0, x);
     }
     
@@ -241,7 +241,7 @@ namespace matrices {
             return val;
         }
 
-        static inline const T& size() {
+        static constexpr inline T size() {
             return P;
         }
 
@@ -451,9 +451,15 @@ namespace matrices {
             return *this = fraction<T>(rhs, 1);
         }
 
-        inline fraction<T>& operator=(const fraction<T>& rhs) {
-            tie() = rhs.as_pair();
-            return *this;
+        inline fraction(const fraction<T>& rhs) = default;
+        inline fraction(fraction<T>&& rhs) = default;
+
+        inline fraction<T>& operator=(const fraction<T>& rhs) = default;
+        inline fraction<T>& operator=(fraction<T>&& rhs) = default;
+
+        inline void swap(fraction<T>& rhs) {
+            std::swap(numer, rhs.numer);
+            std::swap(denom, rhs.denom);
         }
 
         inline bool operator==(const T& rhs) const {
@@ -634,6 +640,11 @@ namespace matrices {
         }
     };
 
+    template <typename T>
+    inline void swap(fraction<T>& lhs, fraction<T>& rhs) {
+        lhs.swap(rhs);
+    }
+
 };
 
 namespace number_utils {
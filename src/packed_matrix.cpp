@@ -0,0 +1 @@
+#include "packed_matrix.hpp"
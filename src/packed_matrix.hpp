@@ -0,0 +1,322 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include "assert.hpp"
+#include "number_types.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    namespace helper {
+
+        template <int P>
+        struct packed_kernels {
+            static_assert(P > 1 && P < (1 << 16), "Packed storage needs a modulus below 2^16");
+
+            typedef typename std::conditional<P < (1 << 8), std::uint8_t, std::uint16_t>::type storage;
+            typedef typename std::conditional<P < (1 << 8), std::uint32_t, std::uint64_t>::type accumulator;
+
+            static constexpr int lanes = 32;
+            static constexpr int barrett_shift = P < (1 << 8) ? 16 : 32;
+            static constexpr std::uint64_t barrett_factor = (std::uint64_t(1) << barrett_shift) / P;
+            static constexpr accumulator max_product = accumulator(P - 1) * (P - 1);
+            static constexpr accumulator lazy_terms = (~accumulator(0) - (P - 1)) / max_product;
+
+            static inline std::uint32_t reduce(std::uint32_t x) {
+                std::uint32_t q;
+                if constexpr (P < (1 << 8))
+                    q = x * std::uint32_t(barrett_factor) >> barrett_shift;
+                else
+                    q = std::uint64_t(x) * barrett_factor >> barrett_shift;
+                std::uint32_t r = x - q * P;
+                return r >= P ? r - P : r;
+            }
+
+            static inline int padded(int cols) {
+                return (cols + lanes - 1) / lanes * lanes;
+            }
+
+            static inline std::uint32_t multiply(std::uint32_t a, std::uint32_t b) {
+                return std::uint64_t(a) * b % P;
+            }
+
+            static std::uint32_t inverse(std::uint32_t a) {
+                std::uint32_t out = 1;
+                for (int e = P - 2; e > 0; e /= 2, a = multiply(a, a)) {
+                    if (e % 2)
+                        out = multiply(out, a);
+                }
+                return out;
+            }
+
+            static inline void add_row(storage* __restrict dst, const storage* __restrict src, int count) {
+                for (int b = 0; b < count; b += lanes) {
+                    for (int j = b; j < b + lanes; j++) {
+                        std::uint32_t x = std::uint32_t(dst[j]) + src[j];
+                        dst[j] = x >= P ? x - P : x;
+                    }
+                }
+            }
+
+            static inline void sub_row(storage* __restrict dst, const storage* __restrict src, int count) {
+                for (int b = 0; b < count; b += lanes) {
+                    for (int j = b; j < b + lanes; j++) {
+                        std::uint32_t x = std::uint32_t(dst[j]) + P - src[j];
+                        dst[j] = x >= P ? x - P : x;
+                    }
+                }
+            }
+
+            static inline void mul_add_row(storage* __restrict dst, const storage* __restrict src, std::uint32_t mult, int count) {
+                for (int b = 0; b < count; b += lanes) {
+                    for (int j = b; j < b + lanes; j++) {
+                        dst[j] = reduce(dst[j] + mult * src[j]);
+                    }
+                }
+            }
+
+            static inline void scale_row(storage* dst, std::uint32_t mult, int count) {
+                for (int b = 0; b < count; b += lanes) {
+                    for (int j = b; j < b + lanes; j++) {
+                        dst[j] = reduce(mult * dst[j]);
+                    }
+                }
+            }
+
+            static inline void accumulate_row(accumulator* __restrict acc, const storage* __restrict src, accumulator mult, int count) {
+                for (int b = 0; b < count; b += lanes) {
+                    for (int j = b; j < b + lanes; j++) {
+                        acc[j] += mult * src[j];
+                    }
+                }
+            }
+        };
+
+    }
+
+    template <int P>
+    class packed_matrix {
+        typedef helper::packed_kernels<P> kernels;
+        typedef typename kernels::storage storage;
+        typedef typename kernels::accumulator accumulator;
+
+        int ROWS, COLS, STRIDE;
+        std::vector<storage> elements;
+
+        inline storage* row_ptr(int row) {
+            return &elements[(size_t)row * STRIDE];
+        }
+
+        inline const storage* row_ptr(int row) const {
+            return &elements[(size_t)row * STRIDE];
+        }
+
+        inline void check_index(int row, int col) const {
+            do_assert(row >= 0 && row < ROWS && col >= 0 && col < COLS, "Index out of bounds");
+        }
+
+        inline void check_dimen(const packed_matrix<P>& m) const {
+            do_assert(ROWS == m.ROWS && COLS == m.COLS, "Incompatible matrix dimensions");
+        }
+
+        std::pair<int, std::uint32_t> eliminate(bool reduced, int pivot_limit) {
+            int r = 0, swaps = 0;
+            std::uint32_t det = 1;
+            for (int p = 0; p < pivot_limit && r < ROWS; p++) {
+                int i = r;
+                while (i < ROWS && row_ptr(i)[p] == 0) {
+                    i++;
+                }
+                if (i == ROWS)
+                    continue;
+                if (i != r) {
+                    std::swap_ranges(row_ptr(i), row_ptr(i) + STRIDE, row_ptr(r));
+                    swaps++;
+                }
+                int start = p / kernels::lanes * kernels::lanes, count = STRIDE - start;
+                storage* pivot = row_ptr(r);
+                det = kernels::multiply(det, pivot[p]);
+                if (reduced)
+                    kernels::scale_row(pivot + start, kernels::inverse(pivot[p]), count);
+                std::uint32_t pivot_inverse = reduced ? 1 : kernels::inverse(pivot[p]);
+                for (int j = reduced ? 0 : r + 1; j < ROWS; j++) {
+                    storage* row = row_ptr(j);
+                    if (j == r || row[p] == 0)
+                        continue;
+                    std::uint32_t factor = kernels::multiply(row[p], pivot_inverse);
+                    kernels::mul_add_row(row + start, pivot + start, P - factor, count);
+                }
+                r++;
+            }
+            if (swaps % 2)
+                det = (P - det) % P;
+            return std::make_pair(r, det);
+        }
+
+        packed_matrix<P> augment(const packed_matrix<P>& rhs) const {
+            do_assert(ROWS == rhs.ROWS, "Incompatible matrix dimensions for augmentation");
+            packed_matrix<P> out(ROWS, COLS + rhs.COLS);
+            for (int i = 0; i < ROWS; i++) {
+                std::copy(row_ptr(i), row_ptr(i) + COLS, out.row_ptr(i));
+                std::copy(rhs.row_ptr(i), rhs.row_ptr(i) + rhs.COLS, out.row_ptr(i) + COLS);
+            }
+            return out;
+        }
+
+    public:
+        packed_matrix(int rows, int columns) : ROWS(rows), COLS(columns), STRIDE(kernels::padded(columns)) {
+            do_assert(ROWS > 0 && COLS > 0, "Matrix size must be positive");
+            elements.assign((size_t)ROWS * STRIDE, 0);
+        }
+
+        explicit packed_matrix(const dynamic_matrix<int_finite_field<P>>& m) : packed_matrix(m.rows(), m.cols()) {
+            for (int i = 0; i < ROWS; i++) {
+                for (int j = 0; j < COLS; j++) {
+                    row_ptr(i)[j] = m.element(i, j).value();
+                }
+            }
+        }
+
+        static packed_matrix<P> identity(int size) {
+            packed_matrix<P> out(size, size);
+            for (int i = 0; i < size; i++) {
+                out.row_ptr(i)[i] = 1;
+            }
+            return out;
+        }
+
+        inline std::pair<int, int> dimension() const {
+            return std::make_pair(ROWS, COLS);
+        }
+
+        inline int rows() const {
+            return ROWS;
+        }
+
+        inline int cols() const {
+            return COLS;
+        }
+
+        inline int_finite_field<P> get(int row, int col) const {
+            check_index(row, col);
+            return int_finite_field<P>(row_ptr(row)[col]);
+        }
+
+        inline void set(int row, int col, const int_finite_field<P>& value) {
+            check_index(row, col);
+            row_ptr(row)[col] = value.value();
+        }
+
+        dynamic_matrix<int_finite_field<P>> to_dynamic_matrix() const {
+            dynamic_matrix<int_finite_field<P>> out(ROWS, COLS);
+            for (int i = 0; i < ROWS; i++) {
+                for (int j = 0; j < COLS; j++) {
+                    out.element(i, j) = int_finite_field<P>(row_ptr(i)[j]);
+                }
+            }
+            return out;
+        }
+
+        bool operator==(const packed_matrix<P>& rhs) const {
+            return ROWS == rhs.ROWS && COLS == rhs.COLS && elements == rhs.elements;
+        }
+
+        inline bool operator!=(const packed_matrix<P>& rhs) const {
+            return !(*this == rhs);
+        }
+
+        packed_matrix<P>& operator+=(const packed_matrix<P>& rhs) {
+            check_dimen(rhs);
+            if (&rhs == this)
+                return *this += packed_matrix<P>(rhs);
+            kernels::add_row(elements.data(), rhs.elements.data(), elements.size());
+            return *this;
+        }
+
+        inline packed_matrix<P> operator+(const packed_matrix<P>& rhs) const {
+            packed_matrix<P> out = *this;
+            return out += rhs;
+        }
+
+        packed_matrix<P>& operator-=(const packed_matrix<P>& rhs) {
+            check_dimen(rhs);
+            if (&rhs == this)
+                return *this -= packed_matrix<P>(rhs);
+            kernels::sub_row(elements.data(), rhs.elements.data(), elements.size());
+            return *this;
+        }
+
+        inline packed_matrix<P> operator-(const packed_matrix<P>& rhs) const {
+            packed_matrix<P> out = *this;
+            return out -= rhs;
+        }
+
+        packed_matrix<P> operator*(const packed_matrix<P>& rhs) const {
+            do_assert(COLS == rhs.ROWS, "Incompatible matrix dimensions for multiplication");
+            packed_matrix<P> out(ROWS, rhs.COLS);
+            std::vector<accumulator> acc(rhs.STRIDE);
+            for (int i = 0; i < ROWS; i++) {
+                std::fill(acc.begin(), acc.end(), 0);
+                const storage* a = row_ptr(i);
+                accumulator terms = 0;
+                for (int k = 0; k < COLS; k++) {
+                    if (a[k] == 0)
+                        continue;
+                    if (++terms > kernels::lazy_terms) {
+                        for (accumulator& x : acc) {
+                            x %= P;
+                        }
+                        terms = 1;
+                    }
+                    kernels::accumulate_row(acc.data(), rhs.row_ptr(k), a[k], rhs.STRIDE);
+                }
+                storage* c = out.row_ptr(i);
+                for (int j = 0; j < rhs.COLS; j++) {
+                    c[j] = acc[j] % P;
+                }
+            }
+            return out;
+        }
+
+        inline packed_matrix<P>& operator*=(const packed_matrix<P>& rhs) {
+            return *this = *this * rhs;
+        }
+
+        int compute_RREF_and_rank() {
+            return eliminate(true, COLS).first;
+        }
+
+        packed_matrix<P> compute_RREF() const {
+            packed_matrix<P> out = *this;
+            out.compute_RREF_and_rank();
+            return out;
+        }
+
+        int compute_rank() const {
+            packed_matrix<P> copy = *this;
+            return copy.eliminate(false, COLS).first;
+        }
+
+        int_finite_field<P> compute_determinant() const {
+            do_assert(ROWS == COLS, "Must be a square matrix");
+            packed_matrix<P> copy = *this;
+            std::pair<int, std::uint32_t> result = copy.eliminate(false, COLS);
+            return int_finite_field<P>(result.first == ROWS ? result.second : 0);
+        }
+
+        std::pair<packed_matrix<P>, bool> compute_inverse() const {
+            do_assert(ROWS == COLS, "Must be a square matrix");
+            packed_matrix<P> aug = augment(identity(ROWS)), out(ROWS, COLS);
+            if (aug.eliminate(true, COLS).first < ROWS)
+                return std::make_pair(out, false);
+            for (int i = 0; i < ROWS; i++) {
+                std::copy(aug.row_ptr(i) + COLS, aug.row_ptr(i) + 2 * COLS, out.row_ptr(i));
+            }
+            return std::make_pair(out, true);
+        }
+    };
+
+}
@@ -0,0 +1,77 @@
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include "parallel.hpp"
+
+using namespace std;
+
+namespace matrices {
+
+    namespace helper {
+
+        int task_graph::add(function<void()> run, long long priority, const vector<int>& dependencies) {
+            int id = tasks.size();
+            tasks.push_back({ move(run), {}, (int)dependencies.size(), priority });
+            for (int dependency : dependencies) {
+                tasks[dependency].successors.push_back(id);
+            }
+            return id;
+        }
+
+        void task_graph::run(int threads) {
+            typedef pair<long long, int> entry;
+            priority_queue<entry, vector<entry>, greater<entry>> ready;
+            for (int i = 0; i < (int)tasks.size(); i++) {
+                if (tasks[i].pending == 0)
+                    ready.push({ tasks[i].priority, i });
+            }
+
+            mutex lock;
+            condition_variable wake;
+            int finished = 0, total = tasks.size();
+            exception_ptr error;
+
+            auto worker = [&]() {
+                unique_lock<mutex> guard(lock);
+                while (true) {
+                    wake.wait(guard, [&]() { return !ready.empty() || finished == total || error; });
+                    if (finished == total || error)
+                        return;
+                    int id = ready.top().second;
+                    ready.pop();
+                    guard.unlock();
+                    exception_ptr failure;
+                    try {
+                        tasks[id].run();
+                    } catch (...) {
+                        failure = current_exception();
+                    }
+                    guard.lock();
+                    if (failure && !error)
+                        error = failure;
+                    finished++;
+                    for (int next : tasks[id].successors) {
+                        if (--tasks[next].pending == 0)
+                            ready.push({ tasks[next].priority, next });
+                    }
+                    wake.notify_all();
+                }
+            };
+
+            threads = max(1, min(threads, total));
+            vector<thread> workers;
+            for (int t = 1; t < threads; t++) {
+                workers.emplace_back(worker);
+            }
+            worker();
+            for (auto& w : workers) {
+                w.join();
+            }
+            tasks.clear();
+            if (error)
+                rethrow_exception(error);
+        }
+
+    }
+
+}
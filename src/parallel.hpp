@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <functional>
+
+namespace matrices {
+
+    namespace helper {
+
+        inline int thread_count() {
+            int count = std::thread::hardware_concurrency();
+            return count > 0 ? count : 1;
+        }
+
+        template <typename F>
+        inline void parallel_for(int begin, int end, const F& f) {
+            int threads = std::min(thread_count(), end - begin);
+            if (threads <= 1) {
+                for (int i = begin; i < end; i++) {
+                    f(i);
+                }
+                return;
+            }
+
+            std::vector<std::thread> workers;
+            std::vector<std::exception_ptr> errors(threads);
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back([&, t]() {
+                    try {
+                        for (int i = begin + t; i < end; i += threads) {
+                            f(i);
+                        }
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            for (auto& error : errors) {
+                if (error)
+                    std::rethrow_exception(error);
+            }
+        }
+
+        class task_graph {
+            struct task {
+                std::function<void()> run;
+                std::vector<int> successors;
+                int pending;
+                long long priority;
+            };
+
+            std::vector<task> tasks;
+
+        public:
+            int add(std::function<void()> run, long long priority, const std::vector<int>& dependencies = {});
+
+            inline int size() const {
+                return tasks.size();
+            }
+
+            void run(int threads = thread_count());
+        };
+
+    }
+
+}
@@ -2,9 +2,13 @@
 
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include "dynamic_matrix.hpp"
 #include "matrix.hpp"
 #include "number_types.hpp"
+#include "binary_field.hpp"
+#include "extension_field.hpp"
+#include "semiring.hpp"
 
 namespace matrices {
 
@@ -58,6 +62,43 @@ namespace matrices {
         return os;
     }
 
+    template <int BITS, unsigned POLY>
+    inline std::ostream& operator<<(std::ostream& os, const binary_field<BITS, POLY>& x) {
+        return os << (unsigned)x.value();
+    }
+
+    template <int P, int K, unsigned long long POLY>
+    std::ostream& operator<<(std::ostream& os, const extension_field<P, K, POLY>& x) {
+        std::ostringstream out;
+        for (int i = K - 1; i >= 0; i--) {
+            int c = x.value()[i];
+            if (c == 0)
+                continue;
+            if (out.tellp() > 0)
+                out << '+';
+            if (c != 1 || i == 0)
+                out << c;
+            if (i > 0)
+                out << 'x';
+            if (i > 1)
+                out << '^' << i;
+        }
+        if (out.tellp() == 0)
+            out << 0;
+        return os << out.str();
+    }
+
+    template <typename T, bool MAX>
+    inline std::ostream& operator<<(std::ostream& os, const tropical<T, MAX>& x) {
+        if (x.is_infinite())
+            return os << (MAX ? "-inf" : "inf");
+        return os << x.value();
+    }
+
+    inline std::ostream& operator<<(std::ostream& os, const boolean& x) {
+        return os << (x.value() ? 1 : 0);
+    }
+
     template <typename T>
     inline std::ostream& operator<<(std::ostream& os, const fraction<T>& x) {
         return os << x.numerator() << "/" << x.denominator();
@@ -0,0 +1 @@
+#include "qr_decomposition.hpp"
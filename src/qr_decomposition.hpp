@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "assert.hpp"
+#include "dense_kernels.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    template <typename T>
+    class qr_decomposition {
+        static constexpr int block = 32;
+
+        int m, n;
+        std::vector<T> qr;
+        std::vector<T> tau;
+        std::vector<std::vector<T>> block_t;
+
+        inline T& at(int row, int col) {
+            return qr[(size_t)row * n + col];
+        }
+
+        inline const T& at(int row, int col) const {
+            return qr[(size_t)row * n + col];
+        }
+
+        void reflect(int j, int end) {
+            T alpha = at(j, j), sigma = 0;
+            for (int i = j + 1; i < m; i++) {
+                sigma += at(i, j) * at(i, j);
+            }
+            if (sigma == 0) {
+                tau[j] = 0;
+                return;
+            }
+            T beta = std::sqrt(alpha * alpha + sigma);
+            if (alpha > 0)
+                beta = -beta;
+            tau[j] = (beta - alpha) / beta;
+            T scale = 1 / (alpha - beta);
+            for (int i = j + 1; i < m; i++) {
+                at(i, j) *= scale;
+            }
+            at(j, j) = beta;
+
+            for (int c = j + 1; c < end; c++) {
+                T w = at(j, c);
+                for (int i = j + 1; i < m; i++) {
+                    w += at(i, j) * at(i, c);
+                }
+                w *= tau[j];
+                at(j, c) -= w;
+                for (int i = j + 1; i < m; i++) {
+                    at(i, c) -= w * at(i, j);
+                }
+            }
+        }
+
+        std::vector<T> panel_v(int k, int width) const {
+            std::vector<T> v((size_t)(m - k) * width, 0);
+            for (int i = 0; i < m - k; i++) {
+                for (int c = 0; c < width && c <= i; c++) {
+                    v[(size_t)i * width + c] = c == i ? 1 : at(k + i, k + c);
+                }
+            }
+            return v;
+        }
+
+        std::vector<T> panel_t(int k, int width, const std::vector<T>& v) const {
+            std::vector<T> t((size_t)width * width, 0);
+            for (int c = 0; c < width; c++) {
+                t[(size_t)c * width + c] = tau[k + c];
+                std::vector<T> z(c, 0);
+                for (int i = 0; i < m - k; i++) {
+                    const T* vi = &v[(size_t)i * width];
+                    for (int r = 0; r < c; r++) {
+                        z[r] += vi[r] * vi[c];
+                    }
+                }
+                for (int r = 0; r < c; r++) {
+                    T sum = 0;
+                    for (int s = r; s < c; s++) {
+                        sum += t[(size_t)r * width + s] * z[s];
+                    }
+                    t[(size_t)r * width + c] = -tau[k + c] * sum;
+                }
+            }
+            return t;
+        }
+
+        void apply_block(int k, int width, const std::vector<T>& v, const std::vector<T>& t, bool transposed,
+                         T* b, int ldb, int cols) const {
+            int rows = m - k;
+            std::vector<T> vt((size_t)width * rows), w((size_t)width * cols, 0), y((size_t)width * cols, 0);
+            for (int i = 0; i < rows; i++) {
+                for (int c = 0; c < width; c++) {
+                    vt[(size_t)c * rows + i] = v[(size_t)i * width + c];
+                }
+            }
+            helper::dense_kernels<T>::gemm_subtract(w.data(), cols, vt.data(), rows, b, ldb, width, rows, cols);
+            for (int r = 0; r < width; r++) {
+                for (int s = 0; s < width; s++) {
+                    const T& coef = transposed ? t[(size_t)s * width + r] : t[(size_t)r * width + s];
+                    if (coef == 0)
+                        continue;
+                    for (int j = 0; j < cols; j++) {
+                        y[(size_t)r * cols + j] -= coef * w[(size_t)s * cols + j];
+                    }
+                }
+            }
+            helper::dense_kernels<T>::gemm_subtract(b, ldb, v.data(), width, y.data(), cols, rows, width, cols);
+        }
+
+        void factorize() {
+            for (int k = 0; k < n; k += block) {
+                int width = std::min(block, n - k);
+                for (int j = k; j < k + width; j++) {
+                    reflect(j, k + width);
+                }
+                std::vector<T> v = panel_v(k, width);
+                block_t.push_back(panel_t(k, width, v));
+                if (k + width < n)
+                    apply_block(k, width, v, block_t.back(), true, &at(k, k + width), n, n - k - width);
+            }
+        }
+
+        std::vector<T> to_vector(const dynamic_matrix<T>& b) const {
+            do_assert(b.rows() == m, "Incompatible matrix dimensions for QR");
+            std::vector<T> out((size_t)b.rows() * b.cols());
+            for (int i = 0; i < b.rows(); i++) {
+                for (int j = 0; j < b.cols(); j++) {
+                    out[(size_t)i * b.cols() + j] = b.element(i, j);
+                }
+            }
+            return out;
+        }
+
+        static dynamic_matrix<T> to_matrix(const std::vector<T>& x, int rows, int cols) {
+            dynamic_matrix<T> out(rows, cols);
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    out.element(i, j) = x[(size_t)i * cols + j];
+                }
+            }
+            return out;
+        }
+
+        void apply(std::vector<T>& b, int cols, bool transposed) const {
+            int panels = block_t.size();
+            for (int p = 0; p < panels; p++) {
+                int index = transposed ? p : panels - 1 - p, k = index * block, width = std::min(block, n - k);
+                apply_block(k, width, panel_v(k, width), block_t[index], transposed, &b[(size_t)k * cols], cols, cols);
+            }
+        }
+
+        void solve_r(std::vector<T>& x, int cols) const {
+            do_assert(is_full_rank(), "Cannot solve the least squares problem - rank deficient");
+            helper::dense_kernels<T>::trsm_upper(qr.data(), n, x.data(), cols, n, cols, false);
+        }
+
+    public:
+        explicit qr_decomposition(const dynamic_matrix<T>& a) : m(a.rows()), n(a.cols()), tau(a.cols()) {
+            do_assert(m >= n, "QR decomposition needs at least as many rows as columns");
+            qr.resize((size_t)m * n);
+            for (int i = 0; i < m; i++) {
+                for (int j = 0; j < n; j++) {
+                    at(i, j) = a.element(i, j);
+                }
+            }
+            factorize();
+        }
+
+        inline std::pair<int, int> dimension() const {
+            return std::make_pair(m, n);
+        }
+
+        bool is_full_rank() const {
+            for (int i = 0; i < n; i++) {
+                if (at(i, i) == 0)
+                    return false;
+            }
+            return true;
+        }
+
+        dynamic_matrix<T> r() const {
+            dynamic_matrix<T> out(n, n, 0);
+            for (int i = 0; i < n; i++) {
+                for (int j = i; j < n; j++) {
+                    out.element(i, j) = at(i, j);
+                }
+            }
+            return out;
+        }
+
+        dynamic_matrix<T> thin_q() const {
+            std::vector<T> q((size_t)m * n, 0);
+            for (int i = 0; i < n; i++) {
+                q[(size_t)i * n + i] = 1;
+            }
+            apply(q, n, false);
+            return to_matrix(q, m, n);
+        }
+
+        dynamic_matrix<T> apply_q(const dynamic_matrix<T>& b) const {
+            std::vector<T> x = to_vector(b);
+            apply(x, b.cols(), false);
+            return to_matrix(x, m, b.cols());
+        }
+
+        dynamic_matrix<T> apply_qt(const dynamic_matrix<T>& b) const {
+            std::vector<T> x = to_vector(b);
+            apply(x, b.cols(), true);
+            return to_matrix(x, m, b.cols());
+        }
+
+        dynamic_matrix<T> solve_least_squares(const dynamic_matrix<T>& b) const {
+            std::vector<T> x = to_vector(b);
+            apply(x, b.cols(), true);
+            x.resize((size_t)n * b.cols());
+            solve_r(x, b.cols());
+            return to_matrix(x, n, b.cols());
+        }
+
+        std::vector<T> solve_least_squares(const std::vector<T>& b) const {
+            do_assert((int)b.size() == m, "Incompatible matrix dimensions for QR");
+            std::vector<T> x = b;
+            apply(x, 1, true);
+            x.resize(n);
+            solve_r(x, 1);
+            return x;
+        }
+    };
+
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include "semiring.hpp"
+
+using namespace std;
+
+namespace matrices {
+
+    boolean_matrix::boolean_matrix(int rows, int columns) : ROWS(rows), COLS(columns), WORDS((columns + word_bits - 1) / word_bits) {
+        do_assert(ROWS > 0 && COLS > 0, "Matrix size must be positive");
+        bits.assign((size_t)ROWS * WORDS, 0);
+    }
+
+    boolean_matrix::boolean_matrix(const dynamic_matrix<boolean>& m) : boolean_matrix(m.rows(), m.cols()) {
+        for (int i = 0; i < ROWS; i++) {
+            for (int j = 0; j < COLS; j++) {
+                if (m.element(i, j).value())
+                    row_ptr(i)[j / word_bits] |= word(1) << (j % word_bits);
+            }
+        }
+    }
+
+    boolean_matrix boolean_matrix::identity(int size) {
+        boolean_matrix out(size, size);
+        for (int i = 0; i < size; i++) {
+            out.set(i, i, true);
+        }
+        return out;
+    }
+
+    dynamic_matrix<boolean> boolean_matrix::to_dynamic_matrix() const {
+        dynamic_matrix<boolean> out(ROWS, COLS, false);
+        for (int i = 0; i < ROWS; i++) {
+            for (int j = 0; j < COLS; j++) {
+                if (get(i, j))
+                    out.element(i, j) = true;
+            }
+        }
+        return out;
+    }
+
+    bool boolean_matrix::operator==(const boolean_matrix& rhs) const {
+        return ROWS == rhs.ROWS && COLS == rhs.COLS && bits == rhs.bits;
+    }
+
+    boolean_matrix& boolean_matrix::operator+=(const boolean_matrix& rhs) {
+        do_assert(ROWS == rhs.ROWS && COLS == rhs.COLS, "Incompatible matrix dimensions for addition");
+        if (&rhs != this)
+            or_row(bits.data(), rhs.bits.data(), bits.size());
+        return *this;
+    }
+
+    boolean_matrix boolean_matrix::operator*(const boolean_matrix& rhs) const {
+        do_assert(COLS == rhs.ROWS, "Incompatible matrix dimensions for multiplication");
+        boolean_matrix out(ROWS, rhs.COLS);
+        int width = rhs.WORDS;
+        int block = max(min_block_rows, (ROWS + helper::thread_count() - 1) / helper::thread_count());
+        auto run = [&](int b) {
+            int i0 = b * block, i1 = min(ROWS, i0 + block);
+            vector<word> table((size_t)width << table_bits);
+            for (int k0 = 0; k0 < COLS; k0 += table_bits) {
+                int k = min(table_bits, COLS - k0), shift = k0 % word_bits, index_word = k0 / word_bits;
+                word mask = (word(1) << k) - 1;
+                for (int idx = 1; idx < (1 << k); idx++) {
+                    word* entry = &table[(size_t)idx * width];
+                    const word* row = rhs.row_ptr(k0 + __builtin_ctz(idx));
+                    copy(row, row + width, entry);
+                    or_row(entry, &table[(size_t)(idx & (idx - 1)) * width], width);
+                }
+                for (int i = i0; i < i1; i++) {
+                    int idx = row_ptr(i)[index_word] >> shift & mask;
+                    if (idx)
+                        or_row(out.row_ptr(i), &table[(size_t)idx * width], width);
+                }
+            }
+        };
+        helper::parallel_for(0, (ROWS + block - 1) / block, run);
+        return out;
+    }
+
+    boolean_matrix boolean_matrix::operator^(int power) const {
+        do_assert(ROWS == COLS, "Must be a square matrix");
+        do_assert(power >= 0, "Negative powers are not defined over a semiring");
+        boolean_matrix out = identity(ROWS), base = *this;
+        for (; power > 0; power /= 2) {
+            if (power % 2)
+                out *= base;
+            if (power > 1)
+                base *= base;
+        }
+        return out;
+    }
+
+    boolean_matrix boolean_matrix::transpose() const {
+        boolean_matrix out(COLS, ROWS);
+        for (int i = 0; i < ROWS; i++) {
+            for (int j = 0; j < COLS; j++) {
+                if (get(i, j))
+                    out.set(j, i, true);
+            }
+        }
+        return out;
+    }
+
+    boolean_matrix boolean_matrix::compute_closure() const {
+        do_assert(ROWS == COLS, "Must be a square matrix");
+        boolean_matrix out = *this + identity(ROWS);
+        for (int length = 1; length < ROWS; length *= 2) {
+            boolean_matrix next = out * out;
+            if (next == out)
+                break;
+            out = next;
+        }
+        return out;
+    }
+
+    ostream& operator<<(ostream& os, const boolean_matrix& m) {
+        for (int i = 0; i < m.rows(); i++) {
+            os << "| ";
+            for (int j = 0; j < m.cols(); j++) {
+                os << (m.get(i, j) ? '1' : '0');
+            }
+            os << " |\n";
+        }
+        return os;
+    }
+
+}
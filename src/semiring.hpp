@@ -0,0 +1,356 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "parallel.hpp"
+#include "dense_kernels.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    template <typename T, bool MAX>
+    class tropical {
+        T val;
+
+    public:
+        static constexpr inline T infinity() {
+            if constexpr (std::numeric_limits<T>::has_infinity)
+                return MAX ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+            else
+                return MAX ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+        }
+
+        inline tropical() : val(infinity()) { }
+        inline tropical(const T& value) : val(value) { }
+
+        inline const T& value() const {
+            return val;
+        }
+
+        inline bool is_infinite() const {
+            return val == infinity();
+        }
+
+        inline bool operator==(const tropical<T, MAX>& rhs) const {
+            return val == rhs.val;
+        }
+
+        inline bool operator!=(const tropical<T, MAX>& rhs) const {
+            return val != rhs.val;
+        }
+
+        inline tropical<T, MAX> operator+(const tropical<T, MAX>& rhs) const {
+            return MAX ? std::max(val, rhs.val) : std::min(val, rhs.val);
+        }
+
+        inline tropical<T, MAX>& operator+=(const tropical<T, MAX>& rhs) {
+            return *this = *this + rhs;
+        }
+
+        inline tropical<T, MAX> operator*(const tropical<T, MAX>& rhs) const {
+            return is_infinite() || rhs.is_infinite() ? tropical<T, MAX>() : tropical<T, MAX>(val + rhs.val);
+        }
+
+        inline tropical<T, MAX>& operator*=(const tropical<T, MAX>& rhs) {
+            return *this = *this * rhs;
+        }
+    };
+
+    template <typename T>
+    using min_plus = tropical<T, false>;
+
+    template <typename T>
+    using max_plus = tropical<T, true>;
+
+    class boolean {
+        bool val;
+
+    public:
+        inline boolean() : val(false) { }
+        inline boolean(bool value) : val(value) { }
+
+        inline bool value() const {
+            return val;
+        }
+
+        inline bool operator==(const boolean& rhs) const {
+            return val == rhs.val;
+        }
+
+        inline bool operator!=(const boolean& rhs) const {
+            return val != rhs.val;
+        }
+
+        inline boolean operator+(const boolean& rhs) const {
+            return val || rhs.val;
+        }
+
+        inline boolean& operator+=(const boolean& rhs) {
+            val = val || rhs.val;
+            return *this;
+        }
+
+        inline boolean operator*(const boolean& rhs) const {
+            return val && rhs.val;
+        }
+
+        inline boolean& operator*=(const boolean& rhs) {
+            val = val && rhs.val;
+            return *this;
+        }
+    };
+
+    class boolean_matrix {
+        typedef std::uint64_t word;
+        static constexpr int word_bits = 64;
+        static constexpr int table_bits = 8;
+        static constexpr int min_block_rows = 256;
+
+        int ROWS, COLS, WORDS;
+        std::vector<word> bits;
+
+        inline word* row_ptr(int row) {
+            return &bits[(size_t)row * WORDS];
+        }
+
+        inline const word* row_ptr(int row) const {
+            return &bits[(size_t)row * WORDS];
+        }
+
+        inline void check_index(int row, int col) const {
+            do_assert(row >= 0 && row < ROWS && col >= 0 && col < COLS, "Index out of bounds");
+        }
+
+        static inline void or_row(word* __restrict dst, const word* __restrict src, int count) {
+            for (int w = 0; w < count; w++) {
+                dst[w] |= src[w];
+            }
+        }
+
+    public:
+        boolean_matrix(int rows, int columns);
+
+        explicit boolean_matrix(const dynamic_matrix<boolean>& m);
+
+        static boolean_matrix identity(int size);
+
+        inline std::pair<int, int> dimension() const {
+            return std::make_pair(ROWS, COLS);
+        }
+
+        inline int rows() const {
+            return ROWS;
+        }
+
+        inline int cols() const {
+            return COLS;
+        }
+
+        inline bool get(int row, int col) const {
+            check_index(row, col);
+            return row_ptr(row)[col / word_bits] >> (col % word_bits) & 1;
+        }
+
+        inline void set(int row, int col, bool value) {
+            check_index(row, col);
+            word mask = word(1) << (col % word_bits);
+            if (value)
+                row_ptr(row)[col / word_bits] |= mask;
+            else
+                row_ptr(row)[col / word_bits] &= ~mask;
+        }
+
+        dynamic_matrix<boolean> to_dynamic_matrix() const;
+
+        bool operator==(const boolean_matrix& rhs) const;
+
+        inline bool operator!=(const boolean_matrix& rhs) const {
+            return !(*this == rhs);
+        }
+
+        boolean_matrix& operator+=(const boolean_matrix& rhs);
+
+        inline boolean_matrix operator+(const boolean_matrix& rhs) const {
+            boolean_matrix out = *this;
+            return out += rhs;
+        }
+
+        boolean_matrix operator*(const boolean_matrix& rhs) const;
+
+        inline boolean_matrix& operator*=(const boolean_matrix& rhs) {
+            return *this = *this * rhs;
+        }
+
+        boolean_matrix operator^(int power) const;
+
+        inline boolean_matrix& operator^=(int power) {
+            return *this = *this ^ power;
+        }
+
+        boolean_matrix transpose() const;
+
+        boolean_matrix compute_closure() const;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const boolean_matrix& m);
+
+    namespace helper {
+
+        template <typename T, bool MAX>
+        struct semiring_gemm<tropical<T, MAX>> {
+            typedef tropical<T, MAX> element;
+            static constexpr bool specialized = true;
+            static constexpr int lanes = 32;
+            static constexpr int block_rows = 64;
+            static constexpr int block_inner = 256;
+            static constexpr int block_cols = 1024;
+            static constexpr long long parallel_work = 1 << 20;
+
+            static inline T extend(T x, T y) {
+                if constexpr (std::numeric_limits<T>::has_infinity)
+                    return x + y;
+                else
+                    return y == element::infinity() ? y : x + y;
+            }
+
+            static inline T better(T current, T candidate) {
+                if constexpr (MAX)
+                    return candidate > current ? candidate : current;
+                else
+                    return candidate < current ? candidate : current;
+            }
+
+            static inline void relax_row(element* __restrict c, const element* __restrict b, T x, int count) {
+                int j = 0;
+                for (; j + lanes <= count; j += lanes) {
+                    for (int l = j; l < j + lanes; l++) {
+                        c[l] = element(better(c[l].value(), extend(x, b[l].value())));
+                    }
+                }
+                for (; j < count; j++) {
+                    c[j] = element(better(c[j].value(), extend(x, b[j].value())));
+                }
+            }
+
+            static void multiply(element* out, const element* lhs, const element* rhs, int rows, int inner, int cols) {
+                std::fill(out, out + (size_t)rows * cols, element());
+                auto run = [&](int block) {
+                    int i0 = block * block_rows, i1 = std::min(rows, i0 + block_rows);
+                    for (int j0 = 0; j0 < cols; j0 += block_cols) {
+                        int width = std::min(cols - j0, block_cols);
+                        for (int k0 = 0; k0 < inner; k0 += block_inner) {
+                            int k1 = std::min(inner, k0 + block_inner);
+                            for (int i = i0; i < i1; i++) {
+                                for (int k = k0; k < k1; k++) {
+                                    const element& x = lhs[(size_t)i * inner + k];
+                                    if (!x.is_infinite())
+                                        relax_row(out + (size_t)i * cols + j0, rhs + (size_t)k * cols + j0, x.value(), width);
+                                }
+                            }
+                        }
+                    }
+                };
+                int blocks = (rows + block_rows - 1) / block_rows;
+                if ((long long)rows * inner * cols >= parallel_work) {
+                    parallel_for(0, blocks, run);
+                } else {
+                    for (int block = 0; block < blocks; block++) {
+                        run(block);
+                    }
+                }
+            }
+        };
+
+        template <>
+        struct semiring_gemm<boolean> {
+            static constexpr bool specialized = true;
+
+            static void multiply(boolean* out, const boolean* lhs, const boolean* rhs, int rows, int inner, int cols) {
+                boolean_matrix a(rows, inner), b(inner, cols);
+                for (int i = 0; i < rows; i++) {
+                    for (int k = 0; k < inner; k++) {
+                        if (lhs[(size_t)i * inner + k].value())
+                            a.set(i, k, true);
+                    }
+                }
+                for (int k = 0; k < inner; k++) {
+                    for (int j = 0; j < cols; j++) {
+                        if (rhs[(size_t)k * cols + j].value())
+                            b.set(k, j, true);
+                    }
+                }
+                boolean_matrix c = a * b;
+                for (int i = 0; i < rows; i++) {
+                    for (int j = 0; j < cols; j++) {
+                        out[(size_t)i * cols + j] = c.get(i, j);
+                    }
+                }
+            }
+        };
+
+    }
+
+    template <typename T>
+    dynamic_matrix<T> compute_closure(const dynamic_matrix<T>& a) {
+        do_assert(a.rows() == a.cols(), "Must be a square matrix");
+        dynamic_matrix<T> out = a;
+        for (int i = 0; i < a.rows(); i++) {
+            out.element(i, i) += number_utils::get_one<T>(a.element(0, 0));
+        }
+        for (int length = 1; length < a.rows(); length *= 2) {
+            dynamic_matrix<T> next = out * out;
+            if (next == out)
+                break;
+            out = next;
+        }
+        return out;
+    }
+
+}
+
+namespace number_utils {
+
+    template <typename T, bool MAX>
+    struct standard_numbers<matrices::tropical<T, MAX>> {
+        static inline matrices::tropical<T, MAX> zero() {
+            return matrices::tropical<T, MAX>();
+        }
+
+        static inline matrices::tropical<T, MAX> one() {
+            return matrices::tropical<T, MAX>(0);
+        }
+
+        static inline matrices::tropical<T, MAX> zero(const matrices::tropical<T, MAX>& sample) {
+            return matrices::tropical<T, MAX>();
+        }
+
+        static inline matrices::tropical<T, MAX> one(const matrices::tropical<T, MAX>& sample) {
+            return matrices::tropical<T, MAX>(0);
+        }
+    };
+
+    template <>
+    struct standard_numbers<matrices::boolean> {
+        static inline matrices::boolean zero() {
+            return matrices::boolean(false);
+        }
+
+        static inline matrices::boolean one() {
+            return matrices::boolean(true);
+        }
+
+        static inline matrices::boolean zero(const matrices::boolean& sample) {
+            return matrices::boolean(false);
+        }
+
+        static inline matrices::boolean one(const matrices::boolean& sample) {
+            return matrices::boolean(true);
+        }
+    };
+
+}
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include "sparse_lu.hpp"
+
+using namespace std;
+
+namespace matrices {
+
+    namespace helper {
+
+        // Approximate minimum degree on the quotient graph of A + A^T: an eliminated pivot becomes an element
+        // that stands for the clique of its neighbours instead of adding the clique edges, variables with the
+        // same adjacency are merged into supervariables and degrees are upper bounds computed from element sizes.
+        vector<int> minimum_degree_order(int n, const vector<int>& starts, const vector<int>& indices) {
+            enum : char { variable, element, absorbed, merged };
+            vector<vector<int>> vars(n), elems(n), element_vars(n);
+            for (int i = 0; i < n; i++) {
+                for (int k = starts[i]; k < starts[i + 1]; k++) {
+                    if (indices[k] != i) {
+                        vars[i].push_back(indices[k]);
+                        vars[indices[k]].push_back(i);
+                    }
+                }
+            }
+            vector<int> nv(n, 1), degree(n), weight(n, 0), head(n + 1, -1), next(n, -1), prev(n, -1);
+            vector<int> mark(n, 0), flag(n, 0), outside(n), member_next(n, -1), member_last(n);
+            vector<unsigned long long> hash(n);
+            vector<char> status(n, variable);
+            auto insert = [&](int i) {
+                next[i] = head[degree[i]];
+                prev[i] = -1;
+                if (next[i] != -1)
+                    prev[next[i]] = i;
+                head[degree[i]] = i;
+            };
+            auto remove = [&](int i) {
+                if (prev[i] != -1)
+                    next[prev[i]] = next[i];
+                else
+                    head[degree[i]] = next[i];
+                if (next[i] != -1)
+                    prev[next[i]] = prev[i];
+            };
+            for (int i = 0; i < n; i++) {
+                sort(vars[i].begin(), vars[i].end());
+                vars[i].erase(unique(vars[i].begin(), vars[i].end()), vars[i].end());
+                degree[i] = vars[i].size();
+                member_last[i] = i;
+                insert(i);
+            }
+
+            vector<int> order, pivot_vars;
+            order.reserve(n);
+            int low = 0, stamp = 0, flag_stamp = 0;
+            while ((int)order.size() < n) {
+                while (head[low] == -1) {
+                    low++;
+                }
+                int p = head[low];
+                remove(p);
+                status[p] = element;
+                for (int v = p; v != -1; v = member_next[v]) {
+                    order.push_back(v);
+                }
+
+                // The new element is the union of the absorbed elements and the remaining variable neighbours of p.
+                mark[p] = ++stamp;
+                pivot_vars.clear();
+                int pivot_weight = 0;
+                auto add = [&](int i) {
+                    if (status[i] == variable && mark[i] != stamp) {
+                        mark[i] = stamp;
+                        pivot_vars.push_back(i);
+                        pivot_weight += nv[i];
+                    }
+                };
+                for (int e : elems[p]) {
+                    if (status[e] != element)
+                        continue;
+                    for (int i : element_vars[e]) {
+                        add(i);
+                    }
+                    status[e] = absorbed;
+                    vector<int>().swap(element_vars[e]);
+                }
+                for (int i : vars[p]) {
+                    add(i);
+                }
+                vector<int>().swap(vars[p]);
+                vector<int>().swap(elems[p]);
+
+                // outside[e] = weight of the variables of an older element e that are not in the new element.
+                for (int i : pivot_vars) {
+                    remove(i);
+                    for (int e : elems[i]) {
+                        if (status[e] != element)
+                            continue;
+                        if (flag[e] != stamp) {
+                            flag[e] = stamp;
+                            outside[e] = weight[e];
+                        }
+                        outside[e] -= nv[i];
+                    }
+                }
+
+                int remaining = n - (int)order.size();
+                for (int i : pivot_vars) {
+                    int external = 0;
+                    unsigned long long h = p;
+                    size_t w = 0;
+                    for (int e : elems[i]) {
+                        if (status[e] != element)
+                            continue;
+                        if (outside[e] == 0) {
+                            status[e] = absorbed;
+                            vector<int>().swap(element_vars[e]);
+                            continue;
+                        }
+                        external += outside[e];
+                        h += e;
+                        elems[i][w++] = e;
+                    }
+                    elems[i].resize(w);
+                    elems[i].push_back(p);
+                    w = 0;
+                    for (int j : vars[i]) {
+                        if (status[j] != variable || mark[j] == stamp)
+                            continue;
+                        external += nv[j];
+                        h += j;
+                        vars[i][w++] = j;
+                    }
+                    vars[i].resize(w);
+                    hash[i] = h;
+                    degree[i] = min({ degree[i] + pivot_weight - nv[i], external + pivot_weight - nv[i], remaining - nv[i] });
+                }
+
+                // Variables of the new element with the same elements and neighbours become one supervariable.
+                sort(pivot_vars.begin(), pivot_vars.end(), [&](int a, int b) { return hash[a] != hash[b] ? hash[a] < hash[b] : a < b; });
+                for (size_t a = 0; a < pivot_vars.size(); a++) {
+                    int i = pivot_vars[a];
+                    if (nv[i] == 0)
+                        continue;
+                    flag_stamp = ++stamp;
+                    for (int e : elems[i]) {
+                        flag[e] = flag_stamp;
+                    }
+                    for (int j : vars[i]) {
+                        flag[j] = flag_stamp;
+                    }
+                    for (size_t b = a + 1; b < pivot_vars.size() && hash[pivot_vars[b]] == hash[i]; b++) {
+                        int j = pivot_vars[b];
+                        if (nv[j] == 0 || elems[j].size() != elems[i].size() || vars[j].size() != vars[i].size())
+                            continue;
+                        bool same = all_of(elems[j].begin(), elems[j].end(), [&](int e) { return flag[e] == flag_stamp; }) &&
+                                    all_of(vars[j].begin(), vars[j].end(), [&](int v) { return flag[v] == flag_stamp; });
+                        if (!same)
+                            continue;
+                        degree[i] -= nv[j];
+                        nv[i] += nv[j];
+                        nv[j] = 0;
+                        status[j] = merged;
+                        member_next[member_last[i]] = j;
+                        member_last[i] = member_last[j];
+                        vector<int>().swap(vars[j]);
+                        vector<int>().swap(elems[j]);
+                    }
+                }
+
+                size_t w = 0;
+                for (int i : pivot_vars) {
+                    if (nv[i] == 0)
+                        continue;
+                    degree[i] = max(degree[i], 0);
+                    low = min(low, degree[i]);
+                    insert(i);
+                    pivot_vars[w++] = i;
+                }
+                pivot_vars.resize(w);
+                element_vars[p] = pivot_vars;
+                weight[p] = pivot_weight;
+            }
+            return order;
+        }
+    }
+
+}
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "sparse_matrix.hpp"
+#include "dynamic_matrix.hpp"
+#include "matrix_implementation.hpp"
+
+namespace matrices {
+
+    enum class sparse_ordering { natural, minimum_degree };
+
+    namespace helper {
+
+        std::vector<int> minimum_degree_order(int n, const std::vector<int>& starts, const std::vector<int>& indices);
+
+    }
+
+    template <typename T>
+    class sparse_lu {
+        static constexpr double pivot_threshold = 0.1;
+
+        int n;
+        T zero, one;
+        bool singular;
+        std::vector<int> column_order, pivot_row, pivot_of;
+        std::vector<int> l_starts, l_rows, u_starts, u_rows;
+        std::vector<T> l_values, u_values, diagonal;
+
+        static sparse_matrix<T> columns_of(const sparse_matrix<T>& a) {
+            return a.transpose();
+        }
+
+        void scatter(const sparse_matrix<T>& columns, int k, std::vector<T>& x) const {
+            const std::vector<int>& starts = columns.row_starts();
+            int col = column_order[k];
+            for (int p = starts[col]; p < starts[col + 1]; p++) {
+                x[columns.column_indices()[p]] = columns.values()[p];
+            }
+        }
+
+        std::vector<int> reach(const sparse_matrix<T>& columns, int k, std::vector<int>& mark, std::vector<int>& stack) const {
+            std::vector<int> out;
+            const std::vector<int>& starts = columns.row_starts();
+            int col = column_order[k];
+            for (int p = starts[col]; p < starts[col + 1]; p++) {
+                int root = columns.column_indices()[p];
+                if (mark[root] == k)
+                    continue;
+                mark[root] = k;
+                stack.assign(1, root);
+                while (!stack.empty()) {
+                    int row = stack.back();
+                    stack.pop_back();
+                    out.push_back(row);
+                    int j = pivot_of[row];
+                    if (j < 0)
+                        continue;
+                    for (int q = l_starts[j]; q < l_starts[j + 1]; q++) {
+                        if (mark[l_rows[q]] != k) {
+                            mark[l_rows[q]] = k;
+                            stack.push_back(l_rows[q]);
+                        }
+                    }
+                }
+            }
+            return out;
+        }
+
+        void eliminate_column(int k, std::vector<T>& x) {
+            for (int p = u_starts[k]; p < u_starts[k + 1]; p++) {
+                int j = u_rows[p];
+                const T& u = x[pivot_row[j]];
+                u_values[p] = u;
+                if (u == zero)
+                    continue;
+                for (int q = l_starts[j]; q < l_starts[j + 1]; q++) {
+                    x[l_rows[q]] -= l_values[q] * u;
+                }
+            }
+        }
+
+        int choose_pivot(int k, const std::vector<int>& candidates, const std::vector<T>& x) const {
+            int diagonal_row = column_order[k], best = -1;
+            if constexpr (std::is_arithmetic<T>::value) {
+                T largest = 0;
+                for (int row : candidates) {
+                    if (std::abs(x[row]) > largest) {
+                        largest = std::abs(x[row]);
+                        best = row;
+                    }
+                }
+                for (int row : candidates) {
+                    if (row == diagonal_row && largest > 0 && std::abs(x[row]) >= pivot_threshold * largest)
+                        return row;
+                }
+            } else {
+                for (int row : candidates) {
+                    if (x[row] != zero) {
+                        if (row == diagonal_row)
+                            return row;
+                        if (best < 0)
+                            best = row;
+                    }
+                }
+            }
+            return best;
+        }
+
+        void factorize_numeric(const sparse_matrix<T>& columns) {
+            std::vector<T> x(n, zero);
+            std::vector<int> mark(n, -1), stack;
+            std::vector<bool> used(n, false);
+            int next_free = 0;
+            pivot_row.assign(n, -1);
+            pivot_of.assign(n, -1);
+            l_starts.assign(1, 0);
+            u_starts.assign(1, 0);
+            l_rows.clear();
+            u_rows.clear();
+            l_values.clear();
+            u_values.clear();
+            diagonal.assign(n, zero);
+            singular = false;
+
+            for (int k = 0; k < n; k++) {
+                std::vector<int> touched = reach(columns, k, mark, stack), candidates;
+                std::vector<int> pivots;
+                for (int row : touched) {
+                    if (pivot_of[row] >= 0)
+                        pivots.push_back(pivot_of[row]);
+                    else
+                        candidates.push_back(row);
+                }
+                std::sort(pivots.begin(), pivots.end());
+                u_rows.insert(u_rows.end(), pivots.begin(), pivots.end());
+                u_values.resize(u_rows.size(), zero);
+                u_starts.push_back(u_rows.size());
+
+                scatter(columns, k, x);
+                eliminate_column(k, x);
+                int pivot = choose_pivot(k, candidates, x);
+                if (pivot < 0) {
+                    singular = true;
+                    while (used[next_free]) {
+                        next_free++;
+                    }
+                    pivot = next_free;
+                }
+                used[pivot] = true;
+                pivot_row[k] = pivot;
+                pivot_of[pivot] = k;
+                diagonal[k] = x[pivot];
+                for (int row : candidates) {
+                    if (row == pivot)
+                        continue;
+                    l_rows.push_back(row);
+                    l_values.push_back(diagonal[k] == zero ? zero : x[row] / diagonal[k]);
+                }
+                l_starts.push_back(l_rows.size());
+                for (int row : touched) {
+                    x[row] = zero;
+                }
+            }
+        }
+
+    public:
+        explicit sparse_lu(const sparse_matrix<T>& a, sparse_ordering ordering = sparse_ordering::minimum_degree)
+            : n(a.rows()), zero(number_utils::get_zero<T>(a.element(0, 0))), one(number_utils::get_one<T>(a.element(0, 0))), singular(false) {
+            do_assert(a.rows() == a.cols(), "Must be a square matrix");
+            if (ordering == sparse_ordering::minimum_degree) {
+                column_order = helper::minimum_degree_order(n, a.row_starts(), a.column_indices());
+            } else {
+                column_order.resize(n);
+                for (int i = 0; i < n; i++) {
+                    column_order[i] = i;
+                }
+            }
+            factorize(a);
+        }
+
+        void factorize(const sparse_matrix<T>& a) {
+            do_assert(a.rows() == n && a.cols() == n, "Incompatible matrix dimensions for sparse LU");
+            factorize_numeric(columns_of(a));
+        }
+
+        bool refactor(const sparse_matrix<T>& a) {
+            do_assert(a.rows() == n && a.cols() == n, "Incompatible matrix dimensions for sparse LU");
+            sparse_matrix<T> columns = columns_of(a);
+            std::vector<T> x(n, zero);
+            std::vector<int> mark(n, -1);
+            for (int k = 0; k < n; k++) {
+                for (int p = u_starts[k]; p < u_starts[k + 1]; p++) {
+                    mark[pivot_row[u_rows[p]]] = k;
+                }
+                for (int q = l_starts[k]; q < l_starts[k + 1]; q++) {
+                    mark[l_rows[q]] = k;
+                }
+                mark[pivot_row[k]] = k;
+                int col = column_order[k];
+                for (int p = columns.row_starts()[col]; p < columns.row_starts()[col + 1]; p++) {
+                    do_assert(mark[columns.column_indices()[p]] == k, "Sparsity pattern differs from the analysed one");
+                }
+
+                scatter(columns, k, x);
+                eliminate_column(k, x);
+                diagonal[k] = x[pivot_row[k]];
+                bool acceptable = diagonal[k] != zero;
+                if constexpr (std::is_arithmetic<T>::value) {
+                    T largest = std::abs(diagonal[k]);
+                    for (int q = l_starts[k]; q < l_starts[k + 1]; q++) {
+                        largest = std::max(largest, (T)std::abs(x[l_rows[q]]));
+                    }
+                    acceptable = acceptable && std::abs(diagonal[k]) >= pivot_threshold * largest;
+                }
+                if (!acceptable) {
+                    singular = true;
+                    return false;
+                }
+                for (int q = l_starts[k]; q < l_starts[k + 1]; q++) {
+                    l_values[q] = x[l_rows[q]] / diagonal[k];
+                    x[l_rows[q]] = zero;
+                }
+                for (int p = u_starts[k]; p < u_starts[k + 1]; p++) {
+                    x[pivot_row[u_rows[p]]] = zero;
+                }
+                x[pivot_row[k]] = zero;
+            }
+            singular = false;
+            return true;
+        }
+
+        inline int size() const {
+            return n;
+        }
+
+        inline bool is_singular() const {
+            return singular;
+        }
+
+        inline int non_zeros() const {
+            return l_rows.size() + u_rows.size() + n;
+        }
+
+        inline const std::vector<int>& column_permutation() const {
+            return column_order;
+        }
+
+        inline const std::vector<int>& row_permutation() const {
+            return pivot_row;
+        }
+
+        T determinant() const {
+            if (singular)
+                return zero;
+            T det = one;
+            for (const T& d : diagonal) {
+                det *= d;
+            }
+            bool odd = helper::pluq_impl<T>::is_odd(pivot_row) != helper::pluq_impl<T>::is_odd(column_order);
+            return odd ? -det : det;
+        }
+
+        std::vector<T> solve(const std::vector<T>& b) const {
+            do_assert((int)b.size() == n, "Incompatible matrix dimensions for sparse LU solve");
+            do_assert(!singular, "Cannot solve the system - singular");
+            std::vector<T> w = b, y(n), x(n);
+            for (int k = 0; k < n; k++) {
+                y[k] = w[pivot_row[k]];
+                if (y[k] == zero)
+                    continue;
+                for (int q = l_starts[k]; q < l_starts[k + 1]; q++) {
+                    w[l_rows[q]] -= l_values[q] * y[k];
+                }
+            }
+            for (int k = n - 1; k >= 0; k--) {
+                y[k] /= diagonal[k];
+                if (y[k] == zero)
+                    continue;
+                for (int p = u_starts[k]; p < u_starts[k + 1]; p++) {
+                    y[u_rows[p]] -= u_values[p] * y[k];
+                }
+            }
+            for (int k = 0; k < n; k++) {
+                x[column_order[k]] = y[k];
+            }
+            return x;
+        }
+
+        dynamic_matrix<T> solve(const dynamic_matrix<T>& b) const {
+            do_assert(b.rows() == n, "Incompatible matrix dimensions for sparse LU solve");
+            dynamic_matrix<T> out(n, b.cols());
+            std::vector<T> column(n);
+            for (int j = 0; j < b.cols(); j++) {
+                for (int i = 0; i < n; i++) {
+                    column[i] = b.element(i, j);
+                }
+                column = solve(column);
+                for (int i = 0; i < n; i++) {
+                    out.element(i, j) = column[i];
+                }
+            }
+            return out;
+        }
+    };
+
+}
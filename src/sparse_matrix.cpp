@@ -0,0 +1 @@
+#include "sparse_matrix.hpp"
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <tuple>
+#include <vector>
+#include <algorithm>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "parallel.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    template <typename T>
+    class sparse_matrix {
+        static constexpr int parallel_rows = 4096;
+
+        int ROWS, COLS;
+        T zero;
+        std::vector<int> starts, indices;
+        std::vector<T> entries;
+
+        inline void check_dimen(const sparse_matrix<T>& m) const {
+            do_assert(ROWS == m.ROWS && COLS == m.COLS, "Incompatible matrix dimensions");
+        }
+
+        template <typename F>
+        void for_rows(const F& f) const {
+            if (ROWS < 2 * parallel_rows) {
+                f(0, ROWS);
+                return;
+            }
+            helper::parallel_for(0, (ROWS + parallel_rows - 1) / parallel_rows, [&](int t) {
+                f(t * parallel_rows, std::min(ROWS, (t + 1) * parallel_rows));
+            });
+        }
+
+        void build(std::vector<std::tuple<int, int, T>> triplets) {
+            for (const auto& t : triplets) {
+                do_assert(std::get<0>(t) >= 0 && std::get<0>(t) < ROWS && std::get<1>(t) >= 0 && std::get<1>(t) < COLS, "Index out of bounds");
+            }
+            std::stable_sort(triplets.begin(), triplets.end(), [](const auto& a, const auto& b) {
+                return std::make_pair(std::get<0>(a), std::get<1>(a)) < std::make_pair(std::get<0>(b), std::get<1>(b));
+            });
+            for (size_t i = 0; i < triplets.size();) {
+                int row = std::get<0>(triplets[i]), col = std::get<1>(triplets[i]);
+                T sum = std::get<2>(triplets[i]);
+                for (i++; i < triplets.size() && std::get<0>(triplets[i]) == row && std::get<1>(triplets[i]) == col; i++) {
+                    sum += std::get<2>(triplets[i]);
+                }
+                if (sum != zero) {
+                    starts[row + 1]++;
+                    indices.push_back(col);
+                    entries.push_back(sum);
+                }
+            }
+            for (int i = 0; i < ROWS; i++) {
+                starts[i + 1] += starts[i];
+            }
+        }
+
+        template <typename F>
+        sparse_matrix<T> merge(const sparse_matrix<T>& rhs, const F& combine) const {
+            check_dimen(rhs);
+            sparse_matrix<T> out(ROWS, COLS, zero);
+            for (int i = 0; i < ROWS; i++) {
+                int a = starts[i], b = rhs.starts[i];
+                while (a < starts[i + 1] || b < rhs.starts[i + 1]) {
+                    int col;
+                    T value = zero;
+                    if (b == rhs.starts[i + 1] || (a < starts[i + 1] && indices[a] < rhs.indices[b])) {
+                        col = indices[a];
+                        value = combine(entries[a++], zero);
+                    } else if (a == starts[i + 1] || rhs.indices[b] < indices[a]) {
+                        col = rhs.indices[b];
+                        value = combine(zero, rhs.entries[b++]);
+                    } else {
+                        col = indices[a];
+                        value = combine(entries[a++], rhs.entries[b++]);
+                    }
+                    if (value != zero) {
+                        out.indices.push_back(col);
+                        out.entries.push_back(value);
+                    }
+                }
+                out.starts[i + 1] = out.indices.size();
+            }
+            return out;
+        }
+
+    public:
+        sparse_matrix(int rows, int columns) : sparse_matrix(rows, columns, number_utils::get_zero<T>()) { }
+
+        sparse_matrix(int rows, int columns, const T& sample)
+            : ROWS(rows), COLS(columns), zero(number_utils::get_zero<T>(sample)), starts(rows + 1, 0) {
+            do_assert(ROWS > 0 && COLS > 0, "Matrix size must be positive");
+        }
+
+        sparse_matrix(int rows, int columns, const std::vector<std::tuple<int, int, T>>& triplets)
+            : sparse_matrix(rows, columns, triplets, triplets.empty() ? number_utils::get_zero<T>() : std::get<2>(triplets[0])) { }
+
+        sparse_matrix(int rows, int columns, const std::vector<std::tuple<int, int, T>>& triplets, const T& sample)
+            : sparse_matrix(rows, columns, sample) {
+            build(triplets);
+        }
+
+        explicit sparse_matrix(const dynamic_matrix<T>& m) : sparse_matrix(m.rows(), m.cols(), m.element(0, 0)) {
+            for (int i = 0; i < ROWS; i++) {
+                for (int j = 0; j < COLS; j++) {
+                    if (m.element(i, j) != zero) {
+                        indices.push_back(j);
+                        entries.push_back(m.element(i, j));
+                    }
+                }
+                starts[i + 1] = indices.size();
+            }
+        }
+
+        static sparse_matrix<T> identity(int size, const T& sample) {
+            sparse_matrix<T> out(size, size, sample);
+            T one = number_utils::get_one<T>(sample);
+            for (int i = 0; i < size; i++) {
+                out.indices.push_back(i);
+                out.entries.push_back(one);
+                out.starts[i + 1] = i + 1;
+            }
+            return out;
+        }
+
+        static sparse_matrix<T> identity(int size) {
+            return identity(size, number_utils::get_zero<T>());
+        }
+
+        inline std::pair<int, int> dimension() const {
+            return std::make_pair(ROWS, COLS);
+        }
+
+        inline int rows() const {
+            return ROWS;
+        }
+
+        inline int cols() const {
+            return COLS;
+        }
+
+        inline int non_zeros() const {
+            return entries.size();
+        }
+
+        inline const std::vector<int>& row_starts() const {
+            return starts;
+        }
+
+        inline const std::vector<int>& column_indices() const {
+            return indices;
+        }
+
+        inline const std::vector<T>& values() const {
+            return entries;
+        }
+
+        T element(int row, int col) const {
+            do_assert(row >= 0 && row < ROWS && col >= 0 && col < COLS, "Index out of bounds");
+            auto begin = indices.begin() + starts[row], end = indices.begin() + starts[row + 1];
+            auto it = std::lower_bound(begin, end, col);
+            return it != end && *it == col ? entries[it - indices.begin()] : zero;
+        }
+
+        std::vector<std::tuple<int, int, T>> to_triplets() const {
+            std::vector<std::tuple<int, int, T>> out;
+            out.reserve(entries.size());
+            for (int i = 0; i < ROWS; i++) {
+                for (int k = starts[i]; k < starts[i + 1]; k++) {
+                    out.emplace_back(i, indices[k], entries[k]);
+                }
+            }
+            return out;
+        }
+
+        dynamic_matrix<T> to_dynamic_matrix() const {
+            dynamic_matrix<T> out(ROWS, COLS, zero);
+            for (int i = 0; i < ROWS; i++) {
+                for (int k = starts[i]; k < starts[i + 1]; k++) {
+                    out.element(i, indices[k]) = entries[k];
+                }
+            }
+            return out;
+        }
+
+        bool operator==(const sparse_matrix<T>& rhs) const {
+            return ROWS == rhs.ROWS && COLS == rhs.COLS && starts == rhs.starts && indices == rhs.indices && entries == rhs.entries;
+        }
+
+        inline bool operator!=(const sparse_matrix<T>& rhs) const {
+            return !(*this == rhs);
+        }
+
+        sparse_matrix<T> transpose() const {
+            sparse_matrix<T> out(COLS, ROWS, zero);
+            out.indices.resize(indices.size());
+            out.entries.resize(entries.size());
+            for (int col : indices) {
+                out.starts[col + 1]++;
+            }
+            for (int j = 0; j < COLS; j++) {
+                out.starts[j + 1] += out.starts[j];
+            }
+            std::vector<int> next(out.starts.begin(), out.starts.end() - 1);
+            for (int i = 0; i < ROWS; i++) {
+                for (int k = starts[i]; k < starts[i + 1]; k++) {
+                    int pos = next[indices[k]]++;
+                    out.indices[pos] = i;
+                    out.entries[pos] = entries[k];
+                }
+            }
+            return out;
+        }
+
+        inline sparse_matrix<T> operator+(const sparse_matrix<T>& rhs) const {
+            return merge(rhs, [](const T& a, const T& b) { return a + b; });
+        }
+
+        inline sparse_matrix<T>& operator+=(const sparse_matrix<T>& rhs) {
+            return *this = *this + rhs;
+        }
+
+        inline sparse_matrix<T> operator-(const sparse_matrix<T>& rhs) const {
+            return merge(rhs, [](const T& a, const T& b) { return a - b; });
+        }
+
+        inline sparse_matrix<T>& operator-=(const sparse_matrix<T>& rhs) {
+            return *this = *this - rhs;
+        }
+
+        sparse_matrix<T> operator*(const T& rhs) const {
+            sparse_matrix<T> out(ROWS, COLS, zero);
+            for (int i = 0; i < ROWS; i++) {
+                for (int k = starts[i]; k < starts[i + 1]; k++) {
+                    T value = entries[k] * rhs;
+                    if (value != zero) {
+                        out.indices.push_back(indices[k]);
+                        out.entries.push_back(value);
+                    }
+                }
+                out.starts[i + 1] = out.indices.size();
+            }
+            return out;
+        }
+
+        inline sparse_matrix<T>& operator*=(const T& rhs) {
+            return *this = *this * rhs;
+        }
+
+        std::vector<T> operator*(const std::vector<T>& x) const {
+            do_assert((int)x.size() == COLS, "Incompatible matrix dimensions for multiplication");
+            std::vector<T> y(ROWS, zero);
+            for_rows([&](int r0, int r1) {
+                for (int i = r0; i < r1; i++) {
+                    T sum = zero;
+                    for (int k = starts[i]; k < starts[i + 1]; k++) {
+                        sum += entries[k] * x[indices[k]];
+                    }
+                    y[i] = sum;
+                }
+            });
+            return y;
+        }
+
+        dynamic_matrix<T> operator*(const dynamic_matrix<T>& rhs) const {
+            do_assert(COLS == rhs.rows(), "Incompatible matrix dimensions for multiplication");
+            dynamic_matrix<T> out(ROWS, rhs.cols(), zero);
+            for_rows([&](int r0, int r1) {
+                for (int i = r0; i < r1; i++) {
+                    for (int k = starts[i]; k < starts[i + 1]; k++) {
+                        const T& a = entries[k];
+                        for (int j = 0; j < rhs.cols(); j++) {
+                            out.element(i, j) += a * rhs.element(indices[k], j);
+                        }
+                    }
+                }
+            });
+            return out;
+        }
+
+        sparse_matrix<T> operator*(const sparse_matrix<T>& rhs) const {
+            do_assert(COLS == rhs.ROWS, "Incompatible matrix dimensions for multiplication");
+            sparse_matrix<T> out(ROWS, rhs.COLS, zero);
+            std::vector<T> accumulator(rhs.COLS, zero);
+            std::vector<int> marker(rhs.COLS, -1), used;
+            for (int i = 0; i < ROWS; i++) {
+                used.clear();
+                for (int k = starts[i]; k < starts[i + 1]; k++) {
+                    int row = indices[k];
+                    for (int l = rhs.starts[row]; l < rhs.starts[row + 1]; l++) {
+                        int col = rhs.indices[l];
+                        if (marker[col] != i) {
+                            marker[col] = i;
+                            accumulator[col] = zero;
+                            used.push_back(col);
+                        }
+                        accumulator[col] += entries[k] * rhs.entries[l];
+                    }
+                }
+                std::sort(used.begin(), used.end());
+                for (int col : used) {
+                    if (accumulator[col] != zero) {
+                        out.indices.push_back(col);
+                        out.entries.push_back(accumulator[col]);
+                    }
+                }
+                out.starts[i + 1] = out.indices.size();
+            }
+            return out;
+        }
+
+        inline sparse_matrix<T>& operator*=(const sparse_matrix<T>& rhs) {
+            return *this = *this * rhs;
+        }
+    };
+
+    template <typename T>
+    inline sparse_matrix<T> operator*(const T& lhs, const sparse_matrix<T>& rhs) {
+        return rhs * lhs;
+    }
+
+    template <typename T>
+    dynamic_matrix<T> operator*(const dynamic_matrix<T>& lhs, const sparse_matrix<T>& rhs) {
+        do_assert(lhs.cols() == rhs.rows(), "Incompatible matrix dimensions for multiplication");
+        dynamic_matrix<T> out(lhs.rows(), rhs.cols(), number_utils::get_zero<T>(lhs.element(0, 0)));
+        for (int i = 0; i < lhs.rows(); i++) {
+            for (int k = 0; k < rhs.rows(); k++) {
+                const T& a = lhs.element(i, k);
+                for (int l = rhs.row_starts()[k]; l < rhs.row_starts()[k + 1]; l++) {
+                    out.element(i, rhs.column_indices()[l]) += a * rhs.values()[l];
+                }
+            }
+        }
+        return out;
+    }
+
+}
@@ -0,0 +1 @@
+#include "tiled_elimination.hpp"
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <type_traits>
+#include "numbers.hpp"
+#include "parallel.hpp"
+#include "dense_kernels.hpp"
+
+namespace matrices {
+
+    namespace helper {
+
+        template <typename T>
+        struct tiled_elimination {
+            static constexpr int tile = 64;
+            static constexpr long long min_elements = 256 * 256;
+
+            std::vector<T>& a;
+            const int rows, cols, panels;
+            const T zero, one;
+            std::vector<int> start;
+            std::vector<std::vector<int>> pivot_rows, pivot_cols;
+            std::vector<T> pivot_products;
+
+            tiled_elimination(std::vector<T>& elements, int r, int c)
+                : a(elements), rows(r), cols(c), panels((c + tile - 1) / tile),
+                  zero(number_utils::get_zero<T>(elements[0])), one(number_utils::get_one<T>(elements[0])),
+                  start(panels + 1, 0), pivot_rows(panels), pivot_cols(panels), pivot_products(panels, one) { }
+
+            inline T& at(int row, int col) {
+                return a[(size_t)row * cols + col];
+            }
+
+            int find_pivot(int r, int c) {
+                if constexpr (std::is_arithmetic<T>::value) {
+                    int best = r;
+                    for (int i = r + 1; i < rows; i++) {
+                        if (std::abs(at(i, c)) > std::abs(at(best, c)))
+                            best = i;
+                    }
+                    return at(best, c) == zero ? rows : best;
+                } else {
+                    for (int i = r; i < rows; i++) {
+                        if (at(i, c) != zero)
+                            return i;
+                    }
+                    return rows;
+                }
+            }
+
+            void factor_panel(int k) {
+                int c0 = k * tile, c1 = std::min(cols, c0 + tile), r = start[k];
+                for (int c = c0; c < c1 && r < rows; c++) {
+                    int p = find_pivot(r, c);
+                    if (p == rows)
+                        continue;
+                    if (p != r) {
+                        for (int j = c0; j < c1; j++) {
+                            std::swap(at(r, j), at(p, j));
+                        }
+                    }
+                    pivot_rows[k].push_back(p);
+                    pivot_cols[k].push_back(c);
+                    pivot_products[k] *= at(r, c);
+                    T inv = one / at(r, c);
+                    for (int i = r + 1; i < rows; i++) {
+                        if (at(i, c) == zero)
+                            continue;
+                        T mult = at(i, c) * inv;
+                        at(i, c) = mult;
+                        for (int j = c + 1; j < c1; j++) {
+                            at(i, j) -= mult * at(r, j);
+                        }
+                    }
+                    r++;
+                }
+                start[k + 1] = r;
+            }
+
+            void update_tile(int k, int t) {
+                int c0 = t * tile, c1 = std::min(cols, c0 + tile), r0 = start[k], count = pivot_cols[k].size();
+                for (int s = 0; s < count; s++) {
+                    int p = pivot_rows[k][s];
+                    if (p != r0 + s) {
+                        for (int j = c0; j < c1; j++) {
+                            std::swap(at(r0 + s, j), at(p, j));
+                        }
+                    }
+                }
+                if (count == 0)
+                    return;
+                std::vector<T> l((size_t)(rows - r0) * count, zero);
+                for (int i = r0 + 1; i < rows; i++) {
+                    for (int s = 0; s < count && r0 + s < i; s++) {
+                        l[(size_t)(i - r0) * count + s] = at(i, pivot_cols[k][s]);
+                    }
+                }
+                dense_kernels<T>::trsm_lower(l.data(), count, &at(r0, c0), cols, count, c1 - c0, true);
+                if (r0 + count < rows)
+                    dense_kernels<T>::gemm_subtract(&at(r0 + count, c0), cols, l.data() + (size_t)count * count, count, &at(r0, c0), cols,
+                                                    rows - r0 - count, count, c1 - c0);
+            }
+
+            std::pair<int, T> run(int threads) {
+                task_graph graph;
+                std::vector<int> last(panels, -1);
+                for (int k = 0; k < panels; k++) {
+                    std::vector<int> deps;
+                    if (last[k] >= 0)
+                        deps.push_back(last[k]);
+                    int panel = graph.add([this, k]() { factor_panel(k); }, (long long)k * panels + k, deps);
+                    for (int t = k + 1; t < panels; t++) {
+                        deps = { panel };
+                        if (last[t] >= 0)
+                            deps.push_back(last[t]);
+                        last[t] = graph.add([this, k, t]() { update_tile(k, t); }, (long long)t * panels + k, deps);
+                    }
+                }
+                graph.run(threads);
+
+                int rank = start[panels];
+                T det = one;
+                bool odd = false;
+                for (int k = 0; k < panels; k++) {
+                    det *= pivot_products[k];
+                    for (int s = 0; s < (int)pivot_rows[k].size(); s++) {
+                        if (pivot_rows[k][s] != start[k] + s)
+                            odd = !odd;
+                    }
+                }
+                if (rank < rows || rank < cols)
+                    det = zero;
+                return std::make_pair(rank, odd ? -det : det);
+            }
+
+            static inline bool worthwhile(int r, int c) {
+                return thread_count() > 1 && (long long)r * c >= min_elements;
+            }
+
+            static std::pair<int, T> rank_det(std::vector<T>& elements, int r, int c, int threads = thread_count()) {
+                tiled_elimination<T> engine(elements, r, c);
+                return engine.run(threads);
+            }
+        };
+
+    }
+
+}
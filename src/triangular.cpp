@@ -0,0 +1 @@
+#include "triangular.hpp"
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "dense_kernels.hpp"
+#include "dynamic_matrix.hpp"
+
+namespace matrices {
+
+    enum class triangle { lower, upper };
+
+    enum class side { left, right };
+
+    namespace helper {
+
+        template <typename T>
+        struct triangular_impl {
+            static std::vector<T> to_vector(const dynamic_matrix<T>& m, bool transposed) {
+                std::vector<T> out((size_t)m.rows() * m.cols());
+                for (int i = 0; i < m.rows(); i++) {
+                    for (int j = 0; j < m.cols(); j++) {
+                        if (transposed)
+                            out[(size_t)j * m.rows() + i] = m.element(i, j);
+                        else
+                            out[(size_t)i * m.cols() + j] = m.element(i, j);
+                    }
+                }
+                return out;
+            }
+
+            static void check_diagonal(const dynamic_matrix<T>& a) {
+                const T zero = number_utils::get_zero<T>(a.element(0, 0));
+                for (int i = 0; i < a.rows(); i++) {
+                    do_assert(a.element(i, i) != zero, "Cannot solve the system - singular triangular matrix");
+                }
+            }
+
+            static void solve(const std::vector<T>& a, std::vector<T>& x, int n, int cols, triangle part, bool unit) {
+                if (part == triangle::lower)
+                    dense_kernels<T>::trsm_lower(a.data(), n, x.data(), cols, n, cols, unit);
+                else
+                    dense_kernels<T>::trsm_upper(a.data(), n, x.data(), cols, n, cols, unit);
+            }
+        };
+
+    }
+
+    template <typename T>
+    dynamic_matrix<T> solve_triangular(const dynamic_matrix<T>& a, const dynamic_matrix<T>& b, triangle part,
+                                       bool unit_diagonal = false, side from = side::left) {
+        using impl = helper::triangular_impl<T>;
+        do_assert(a.rows() == a.cols(), "Must be a square matrix");
+        do_assert((from == side::left ? b.rows() : b.cols()) == a.rows(), "Incompatible matrix dimensions for solving");
+        if (!unit_diagonal)
+            impl::check_diagonal(a);
+
+        int n = a.rows();
+        if (from == side::left) {
+            std::vector<T> x = impl::to_vector(b, false);
+            impl::solve(impl::to_vector(a, false), x, n, b.cols(), part, unit_diagonal);
+            dynamic_matrix<T> out(b.rows(), b.cols());
+            for (int i = 0; i < b.rows(); i++) {
+                for (int j = 0; j < b.cols(); j++) {
+                    out.element(i, j) = x[(size_t)i * b.cols() + j];
+                }
+            }
+            return out;
+        }
+
+        std::vector<T> x = impl::to_vector(b, true);
+        impl::solve(impl::to_vector(a, true), x, n, b.rows(), part == triangle::lower ? triangle::upper : triangle::lower, unit_diagonal);
+        dynamic_matrix<T> out(b.rows(), b.cols());
+        for (int i = 0; i < b.rows(); i++) {
+            for (int j = 0; j < b.cols(); j++) {
+                out.element(i, j) = x[(size_t)j * b.rows() + i];
+            }
+        }
+        return out;
+    }
+
+    template <typename T>
+    std::vector<T> solve_triangular(const dynamic_matrix<T>& a, const std::vector<T>& b, triangle part, bool unit_diagonal = false) {
+        using impl = helper::triangular_impl<T>;
+        do_assert(a.rows() == a.cols(), "Must be a square matrix");
+        do_assert((int)b.size() == a.rows(), "Incompatible matrix dimensions for solving");
+        if (!unit_diagonal)
+            impl::check_diagonal(a);
+        std::vector<T> x = b;
+        impl::solve(impl::to_vector(a, false), x, a.rows(), 1, part, unit_diagonal);
+        return x;
+    }
+
+}
@@ -0,0 +1 @@
+#include "wiedemann.hpp"
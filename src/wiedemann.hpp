@@ -0,0 +1,274 @@
+#pragma once
+
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "assert.hpp"
+#include "numbers.hpp"
+#include "parallel.hpp"
+#include "linear_operator.hpp"
+
+namespace matrices {
+
+    namespace helper {
+
+        template <typename F>
+        struct wiedemann_impl {
+            typedef std::vector<F> polynomial;
+
+            static inline F zero() {
+                return number_utils::get_zero<F>();
+            }
+
+            static inline F one() {
+                return number_utils::get_one<F>();
+            }
+
+            static F random_element(std::mt19937& gen, bool non_zero) {
+                std::uniform_int_distribution<unsigned long long> dist(non_zero ? 1 : 0, F::size() - 1);
+                return F(dist(gen));
+            }
+
+            static std::vector<F> random_vector(int n, std::mt19937& gen, bool non_zero = false) {
+                std::vector<F> out(n);
+                for (F& x : out) {
+                    x = random_element(gen, non_zero);
+                }
+                return out;
+            }
+
+            static inline void scale(std::vector<F>& x, const std::vector<F>& d) {
+                for (size_t i = 0; i < x.size(); i++) {
+                    x[i] *= d[i];
+                }
+            }
+
+            static void trim(polynomial& p) {
+                while (p.size() > 1 && p.back() == zero()) {
+                    p.pop_back();
+                }
+            }
+
+            static polynomial multiply(const polynomial& a, const polynomial& b) {
+                polynomial out(a.size() + b.size() - 1, zero());
+                for (size_t i = 0; i < a.size(); i++) {
+                    for (size_t j = 0; j < b.size(); j++) {
+                        out[i + j] += a[i] * b[j];
+                    }
+                }
+                return out;
+            }
+
+            static std::pair<polynomial, polynomial> divide(polynomial a, const polynomial& b) {
+                if (a.size() < b.size())
+                    return std::make_pair(polynomial(1, zero()), a);
+                polynomial q(a.size() - b.size() + 1, zero());
+                F lead = one() / b.back();
+                for (int i = a.size() - b.size(); i >= 0; i--) {
+                    F c = a[i + b.size() - 1] * lead;
+                    q[i] = c;
+                    for (size_t j = 0; j < b.size(); j++) {
+                        a[i + j] -= c * b[j];
+                    }
+                }
+                a.resize(b.size() > 1 ? b.size() - 1 : 1);
+                trim(a);
+                return std::make_pair(q, a);
+            }
+
+            static polynomial monic_gcd(polynomial a, polynomial b) {
+                trim(a);
+                trim(b);
+                while (!(b.size() == 1 && b[0] == zero())) {
+                    polynomial r = divide(a, b).second;
+                    a = b;
+                    b = r;
+                }
+                F lead = one() / a.back();
+                for (F& c : a) {
+                    c *= lead;
+                }
+                return a;
+            }
+
+            static polynomial lcm(const polynomial& a, const polynomial& b) {
+                polynomial out = multiply(a, divide(b, monic_gcd(a, b)).first);
+                trim(out);
+                return out;
+            }
+
+            static polynomial berlekamp_massey(const std::vector<F>& s) {
+                polynomial c(1, one()), b(1, one());
+                int length = 0, shift = 1;
+                F last = one();
+                for (size_t n = 0; n < s.size(); n++) {
+                    F d = s[n];
+                    for (int i = 1; i <= length; i++) {
+                        d += c[i] * s[n - i];
+                    }
+                    if (d == zero()) {
+                        shift++;
+                        continue;
+                    }
+                    polynomial previous = c;
+                    F coef = d / last;
+                    if (c.size() < b.size() + shift)
+                        c.resize(b.size() + shift, zero());
+                    for (size_t i = 0; i < b.size(); i++) {
+                        c[i + shift] -= coef * b[i];
+                    }
+                    if (2 * length <= (int)n) {
+                        length = n + 1 - length;
+                        b = previous;
+                        last = d;
+                        shift = 1;
+                    } else {
+                        shift++;
+                    }
+                }
+                c.resize(length + 1, zero());
+                polynomial out(length + 1);
+                for (int i = 0; i <= length; i++) {
+                    out[i] = c[length - i];
+                }
+                return out;
+            }
+
+            template <typename Apply>
+            static std::vector<F> sequence(const Apply& apply, const std::vector<F>& u, std::vector<F> v, int length) {
+                std::vector<F> out(length, zero());
+                for (int i = 0; i < length; i++) {
+                    if (i > 0)
+                        v = apply(v);
+                    for (size_t j = 0; j < u.size(); j++) {
+                        out[i] += u[j] * v[j];
+                    }
+                }
+                return out;
+            }
+
+            template <typename Apply>
+            static polynomial minimal_polynomial(const Apply& apply, int n, int blocks, std::mt19937& gen, const std::vector<F>* start) {
+                std::vector<std::vector<F>> left(blocks), right(blocks);
+                for (int b = 0; b < blocks; b++) {
+                    left[b] = random_vector(n, gen);
+                    right[b] = start ? *start : random_vector(n, gen);
+                }
+                std::vector<polynomial> parts(blocks);
+                parallel_for(0, blocks, [&](int b) {
+                    parts[b] = berlekamp_massey(sequence(apply, left[b], right[b], 2 * n));
+                });
+                polynomial out = parts[0];
+                for (int b = 1; b < blocks; b++) {
+                    out = lcm(out, parts[b]);
+                }
+                return out;
+            }
+        };
+
+    }
+
+    template <typename F>
+    class wiedemann_solver {
+        typedef helper::wiedemann_impl<F> impl;
+        static constexpr int attempts = 4;
+
+        int blocks;
+        std::mt19937 gen;
+
+        template <typename Op>
+        inline void check_square(const Op& a) const {
+            do_assert(a.rows() == a.cols(), "Must be a square matrix");
+        }
+
+    public:
+        explicit wiedemann_solver(int blocks = 1, unsigned seed = std::mt19937::default_seed) : blocks(blocks), gen(seed) {
+            do_assert(blocks > 0, "Number of blocks must be positive");
+        }
+
+        template <typename Op>
+        std::vector<F> minimal_polynomial(const Op& a) {
+            check_square(a);
+            auto apply = [&](const std::vector<F>& x) { return apply_operator(a, x); };
+            return impl::minimal_polynomial(apply, a.rows(), blocks, gen, nullptr);
+        }
+
+        template <typename Op>
+        int rank(const Op& a) {
+            int best = 0;
+            for (int attempt = 0; attempt < 2; attempt++) {
+                std::vector<F> d1 = impl::random_vector(a.cols(), gen, true), d2 = impl::random_vector(a.rows(), gen, true);
+                auto apply = [&](std::vector<F> x) {
+                    impl::scale(x, d1);
+                    x = apply_operator(a, x);
+                    impl::scale(x, d2);
+                    x = apply_transpose_operator(a, x);
+                    impl::scale(x, d1);
+                    return x;
+                };
+                std::vector<F> f = impl::minimal_polynomial(apply, a.cols(), blocks, gen, nullptr);
+                best = std::max(best, (int)f.size() - 1 - (f[0] == impl::zero() ? 1 : 0));
+            }
+            return best;
+        }
+
+        template <typename Op>
+        F determinant(const Op& a) {
+            check_square(a);
+            int n = a.rows();
+            for (int attempt = 0; attempt < attempts; attempt++) {
+                std::vector<F> d = impl::random_vector(n, gen, true);
+                auto apply = [&](std::vector<F> x) {
+                    impl::scale(x, d);
+                    return apply_operator(a, x);
+                };
+                std::vector<F> f = impl::minimal_polynomial(apply, n, blocks, gen, nullptr);
+                if (f[0] == impl::zero())
+                    return impl::zero();
+                if ((int)f.size() - 1 == n) {
+                    F det = n % 2 ? -f[0] : f[0];
+                    for (const F& x : d) {
+                        det /= x;
+                    }
+                    return det;
+                }
+            }
+            do_assert(false, "Wiedemann did not find the characteristic polynomial, try more blocks");
+            return impl::zero();
+        }
+
+        template <typename Op>
+        std::pair<std::vector<F>, bool> solve(const Op& a, const std::vector<F>& b) {
+            check_square(a);
+            int n = a.rows();
+            do_assert((int)b.size() == n, "Incompatible matrix dimensions for solve");
+            std::vector<F> x(n, impl::zero());
+            if (std::all_of(b.begin(), b.end(), [](const F& v) { return v == impl::zero(); }))
+                return std::make_pair(x, true);
+            auto apply = [&](const std::vector<F>& v) { return apply_operator(a, v); };
+            for (int attempt = 0; attempt < attempts; attempt++) {
+                std::vector<F> f = impl::minimal_polynomial(apply, n, blocks, gen, &b);
+                if (f[0] == impl::zero())
+                    break;
+                int degree = f.size() - 1;
+                std::vector<F> y(n, impl::zero());
+                if (degree > 0)
+                    y = b;
+                for (int i = degree - 1; i >= 1; i--) {
+                    y = apply(y);
+                    for (int j = 0; j < n; j++) {
+                        y[j] += f[i] * b[j];
+                    }
+                }
+                F factor = -impl::one() / f[0];
+                for (F& v : y) {
+                    v *= factor;
+                }
+                if (apply(y) == b)
+                    return std::make_pair(y, true);
+            }
+            return std::make_pair(std::vector<F>(n, impl::zero()), false);
+        }
+    };
+
+}
@@ -26,5 +26,64 @@ int run_test() {
     cout << "m5 ==\n" << m5 << endl;
     cout << "det(m5) ==\n" << m5.compute_determinant_REF() << endl;
 
+    for (int t = 0; t < 6; t++) {
+        int rows = 100 + rand() % 100, cols = t % 2 ? rows : 100 + rand() % 100;
+        vector<int_finite_field<5>> a(rows * cols);
+        vector<double> d(rows * cols);
+        for (int i = 0; i < rows * cols; i++) {
+            a[i] = i >= 3 * cols && t % 3 == 0 ? a[i - cols] + a[i - 3 * cols] : rand() % 5;
+            d[i] = rand() % 19 - 9;
+        }
+        dynamic_matrix<int_finite_field<5>> m6(rows, cols);
+        dynamic_matrix<double> m7(rows, cols);
+        for (int i = 0; i < rows * cols; i++) {
+            m6[i / cols][i % cols] = a[i];
+            m7[i / cols][i % cols] = d[i];
+        }
+        pair<int, int_finite_field<5>> tiled = helper::tiled_elimination<int_finite_field<5>>::rank_det(a, rows, cols, 4);
+        pair<int, int_finite_field<5>> serial = m6.compute_REF_rank_det();
+        do_assert(tiled.first == serial.first, "Wrong tiled rank");
+        do_assert(rows != cols || tiled.second == serial.second, "Wrong tiled determinant");
+        pair<int, double> tiled_double = helper::tiled_elimination<double>::rank_det(d, rows, cols, 4);
+        pair<int, double> serial_double = m7.compute_REF_rank_det();
+        do_assert(tiled_double.first == serial_double.first, "Wrong tiled rank of a double matrix");
+        do_assert(rows != cols || abs(tiled_double.second - serial_double.second) <= 1e-8 * abs(serial_double.second), "Wrong tiled determinant of a double matrix");
+    }
+    cout << "tiled elimination verified" << endl;
+
+    for (int t = 0; t < 2; t++) {
+        int size = 300;
+        dynamic_matrix<int_finite_field<10007>> big(size, size);
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                big[i][j] = t && i >= 2 ? big[i - 1][j] + big[i - 2][j] * 3 : rand() % 10007;
+            }
+        }
+        dynamic_matrix<int_finite_field<10007>> ref = big;
+        pair<int, int_finite_field<10007>> rank_det = ref.compute_REF_rank_det();
+        do_assert(big.compute_rank() == rank_det.first, "Wrong rank of a large matrix");
+        do_assert(big.compute_determinant_REF() == rank_det.second, "Wrong determinant of a large matrix");
+    }
+
+    int n = 80;
+    dynamic_matrix<double> m8(n, n), m9(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            m8[i][j] = (rand() % 2001 - 1000) / 1000.0 + (i == j ? 10 : 0);
+            m9[i][j] = m8[i][j] + (rand() % 3 - 1) / 1000.0;
+        }
+    }
+    pair<dynamic_matrix<double>, bool> inv8 = m8.inverse_iterative(), inv9 = m9.inverse_iterative(inv8.first, 8);
+    dynamic_matrix<double> lu_inv8 = lu_decomposition<double>(m8).inverse().first, lu_inv9 = lu_decomposition<double>(m9).inverse().first;
+    do_assert(inv8.second && inv9.second, "Newton-Schulz iteration should converge");
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            do_assert(abs(inv8.first[i][j] - lu_inv8[i][j]) < 1e-12, "Wrong Newton-Schulz inverse of m8");
+            do_assert(abs(inv9.first[i][j] - lu_inv9[i][j]) < 1e-12, "Wrong warm-started inverse of m9");
+        }
+    }
+    do_assert(!dynamic_matrix<double>(2, 2, { 1, 2, 2, 4 }).inverse_iterative().second, "Singular matrix has no inverse");
+    cout << "Newton-Schulz inverse verified" << endl;
+
     return 0;
 }
@@ -0,0 +1,70 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+#include "test_helpers.hpp"
+
+using namespace std;
+using namespace matrices;
+
+unsigned carryless_multiply(unsigned a, unsigned b, int bits, unsigned poly) {
+    unsigned out = 0;
+    for (int i = 0; i < bits; i++) {
+        if (b >> i & 1)
+            out ^= a << i;
+    }
+    for (int i = 2 * bits - 2; i >= bits; i--) {
+        if (out >> i & 1)
+            out ^= poly << (i - bits);
+    }
+    return out;
+}
+
+template <typename F>
+void check_matrices(mt19937& gen, int n, int bits, unsigned poly) {
+    dynamic_matrix<F> a = random_matrix<F>(gen, n, n + 3, F::size()), b = random_matrix<F>(gen, n + 3, n - 5, F::size());
+    dynamic_matrix<F> product = a * b;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n - 5; j++) {
+            unsigned sum = 0;
+            for (int k = 0; k < n + 3; k++) {
+                sum ^= carryless_multiply(a.element(i, k).value(), b.element(k, j).value(), bits, poly);
+            }
+            do_assert(product.element(i, j) == F(sum), "Wrong matrix product over a binary field");
+        }
+    }
+
+    dynamic_matrix<F> s = random_matrix<F>(gen, n, n, F::size());
+    pair<dynamic_matrix<F>, bool> inverse = s.compute_inverse_RREF();
+    do_assert(inverse.second, "Random matrix over a binary field should be regular");
+    do_assert(s * inverse.first == dynamic_matrix<F>::identity(n) && inverse.first * s == dynamic_matrix<F>::identity(n),
+              "Wrong inverse over a binary field");
+    dynamic_matrix<F> t = s;
+    t *= inverse.first;
+    do_assert(t == dynamic_matrix<F>::identity(n), "Wrong in-place product over a binary field");
+    do_assert(s.compute_rank() == n && s.compute_determinant_REF() != F(0), "Regular matrix must have full rank");
+}
+
+int run_test() {
+    mt19937 gen(43);
+    for (int t = 0; t < 1000; t++) {
+        unsigned a = gen() % 256, b = gen() % 256;
+        do_assert((gf256(a) * gf256(b)).value() == carryless_multiply(a, b, 8, 0x11D), "Wrong GF(2^8) product");
+        do_assert(gf256(a) + gf256(b) == gf256(a ^ b) && gf256(a) - gf256(b) == gf256(a ^ b), "Wrong GF(2^8) sum");
+        if (b)
+            do_assert(gf256(a) / gf256(b) * gf256(b) == gf256(a), "Wrong GF(2^8) division");
+        unsigned c = gen() % 65536, d = gen() % 65536;
+        do_assert((gf65536(c) * gf65536(d)).value() == carryless_multiply(c, d, 16, 0x1100B), "Wrong GF(2^16) product");
+        if (d)
+            do_assert(gf65536(d) * gf65536(d).inverse() == gf65536(1), "Wrong GF(2^16) inverse");
+    }
+    do_assert((gf256(2) ^ 255) == gf256(1) && (gf256(3) ^ -1) == gf256(3).inverse(), "Wrong GF(2^8) power");
+
+    dynamic_matrix<gf256> m1(2, 2, { 1, 2, 3, 4 });
+    cout << "m1 ==\n" << m1 << endl;
+    cout << "m1^-1 ==\n" << m1.compute_inverse_RREF().first << endl;
+    do_assert(m1 * m1.compute_inverse_RREF().first == dynamic_matrix<gf256>::identity(2), "Wrong inverse of m1");
+
+    check_matrices<gf256>(gen, 70, 8, 0x11D);
+    check_matrices<gf65536>(gen, 50, 16, 0x1100B);
+
+    return 0;
+}
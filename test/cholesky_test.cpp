@@ -0,0 +1,91 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+#include "test_helpers.hpp"
+
+using namespace std;
+using namespace matrices;
+
+int run_test() {
+    dynamic_matrix<double> a1(3, 3, { 4, 12, -16, 12, 37, -43, -16, -43, 98 });
+    cholesky_decomposition<double> c1(a1);
+    cout << "a1 ==\n" << a1 << endl;
+    cout << "L ==\n" << c1.lower() << endl;
+    do_assert(c1.lower() == dynamic_matrix<double>(3, 3, { 2, 0, 0, 6, 1, 0, -8, 5, 3 }), "Wrong Cholesky factor of a1");
+    do_assert(abs(c1.log_determinant() - log(36.0)) < 1e-12, "Wrong log determinant of a1");
+
+    dynamic_matrix<double> a2(2, 2, { 1, 2, 2, 1 });
+    ldlt_decomposition<double> l2(a2);
+    do_assert(!l2.is_positive_definite(), "a2 is indefinite");
+    do_assert(l2.subdiagonal()[0] == 2 && l2.determinant() == -3, "a2 needs a 2x2 pivot block");
+    do_assert(!cholesky_decomposition<double>(a2).is_positive_definite(), "a2 is not positive definite");
+    vector<double> x2 = l2.solve(vector<double>{ 3, 3 });
+    do_assert(abs(x2[0] - 1) < 1e-12 && abs(x2[1] - 1) < 1e-12, "Wrong solution of a2 x = (3, 3)");
+
+    dynamic_matrix<double> a4(2, 2, { 0, 1, 1, 0 });
+    ldlt_decomposition<double> l4(a4);
+    do_assert(!l4.is_singular() && l4.determinant() == -1, "Wrong LDL^T of a4");
+    vector<double> x4 = l4.solve(vector<double>{ 2, 3 });
+    do_assert(x4 == vector<double>{ 3, 2 }, "Wrong solution of a4 x = (2, 3)");
+    do_assert(ldlt_decomposition<double>(dynamic_matrix<double>(3, 3, { 1, 2, 3, 2, 4, 6, 3, 6, 9 })).is_singular(), "Rank one matrix is singular");
+
+    for (int m : { 7, 50, 130 }) {
+        dynamic_matrix<double> s(m, m);
+        for (int i = 0; i < m; i++) {
+            for (int j = 0; j <= i; j++) {
+                s[i][j] = s[j][i] = (i + j) % 5 == 0 ? 0 : (rand() % 201 - 100) / 100.0;
+            }
+            s[i][i] = i % 3 == 0 ? 0 : s[i][i];
+        }
+        ldlt_decomposition<double> ls(s);
+        const vector<int>& p = ls.permutation();
+        dynamic_matrix<double> ds(m, m, 0), ps(m, m);
+        for (int i = 0; i < m; i++) {
+            ds[i][i] = ls.diagonal()[i];
+            if (i + 1 < m)
+                ds[i + 1][i] = ds[i][i + 1] = ls.subdiagonal()[i];
+            for (int j = 0; j < m; j++) {
+                ps[i][j] = s[p[i]][p[j]];
+            }
+        }
+        dynamic_matrix<double> lower = ls.lower();
+        do_assert(max_difference(lower * ds * lower.transpose(), ps) < 1e-9, "L D L^T != P s P^T");
+        dynamic_matrix<double> rs(m, 2);
+        for (int i = 0; i < m; i++) {
+            rs[i][0] = rand() % 10;
+            rs[i][1] = rand() % 10;
+        }
+        do_assert(max_difference(s * ls.solve(rs), rs) < 1e-8, "Wrong solution of an indefinite system");
+        double log_det = 0;
+        dynamic_matrix<double> us = lu_decomposition<double>(s).upper();
+        for (int i = 0; i < m; i++) {
+            log_det += log(abs(us[i][i]));
+        }
+        do_assert(abs(ls.log_abs_determinant() - log_det) < 1e-8, "Wrong log determinant of an indefinite matrix");
+    }
+
+    int n = 300;
+    dynamic_matrix<double> b(n, n), rhs(n, 2);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            b[i][j] = (rand() % 201 - 100) / 100.0;
+        }
+        rhs[i][0] = rand() % 10;
+        rhs[i][1] = rand() % 10;
+    }
+    dynamic_matrix<double> a3 = b * b.transpose() + dynamic_matrix<double>::identity(n);
+    cholesky_decomposition<double> c3(a3);
+    do_assert(c3.is_positive_definite(), "a3 is positive definite");
+    dynamic_matrix<double> l3 = c3.lower();
+    do_assert(max_difference(l3 * l3.transpose(), a3) < 1e-9, "L L^T != a3");
+    do_assert(max_difference(a3 * c3.solve(rhs), rhs) < 1e-8, "Wrong solution of a3 x = rhs");
+    do_assert(max_difference(a3 * c3.inverse().first, dynamic_matrix<double>::identity(n)) < 1e-8, "Wrong inverse of a3");
+    dynamic_matrix<double> u3 = lu_decomposition<double>(a3).upper();
+    double log_det = 0;
+    for (int i = 0; i < n; i++) {
+        log_det += log(abs(u3[i][i]));
+    }
+    do_assert(abs(c3.log_determinant() - log_det) < 1e-8, "Wrong log determinant of a3");
+    cout << "Cholesky of a3 verified" << endl;
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+using namespace number_utils;
+
+int run_test() {
+    dynamic_matrix<bigint> a1(3, 3, { 2, 1, 1, 1, 3, 2, 1, 0, 0 }), b1(3, 1, { 4, 5, 6 }), a2(2, 2, { 1, 2, 2, 4 }), b2(2, 1, { 1, 1 });
+
+    pair<dynamic_matrix<fraction<bigint>>, bool> x1 = solve_dixon(a1, b1);
+    cout << "a1 ==\n" << a1 << endl;
+    cout << "b1 ==\n" << b1 << endl;
+    cout << "x1 ==\n" << x1.first << endl;
+    do_assert(x1.second, "a1 is regular");
+    do_assert(x1.first == compute_inverse_multimodular(a1).first * dynamic_matrix<fraction<bigint>>(3, 1, { bigint(4), bigint(5), bigint(6) }),
+              "Wrong solution of a1 x = b1");
+    do_assert(!solve_dixon(a2, b2).second, "a2 is singular");
+
+    int n = 10, k = 2;
+    dynamic_matrix<bigint> a3(n, n), b3(n, k);
+    dynamic_matrix<fraction<bigint>> augmented(n, n + k);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n + k; j++) {
+            int x = rand() % 2001 - 1000;
+            if (j < n)
+                a3[i][j] = x;
+            else
+                b3[i][j - n] = x;
+            augmented[i][j] = fraction<bigint>(x);
+        }
+    }
+    pair<dynamic_matrix<fraction<bigint>>, bool> x3 = solve_dixon(a3, b3);
+    do_assert(x3.second, "a3 should be regular");
+    augmented.do_RREF();
+    for (int i = 0; i < n; i++) {
+        for (int c = 0; c < k; c++) {
+            do_assert(x3.first[i][c] == augmented[i][n + c], "Wrong solution of a3 x = b3");
+        }
+    }
+    cout << "x3 verified" << endl;
+
+    int m = 100;
+    dynamic_matrix<bigint> a4(m, m), b4(m, 1);
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < m; j++) {
+            a4[i][j] = i == m - 1 ? a4[0][j] : bigint(rand() % (1 << 20));
+        }
+        b4[i][0] = i;
+    }
+    do_assert(!solve_dixon(a4, b4).second, "a4 is singular even when its Hadamard bound exceeds 64 primes");
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+using namespace number_utils;
+
+int run_test() {
+    echelon_basis<fraction<bigint>> b1(4);
+    typedef fraction<bigint> F;
+    do_assert(b1.insert({ F(bigint(0)), F(bigint(2)), F(bigint(4)), F(bigint(2)) }), "First row must be independent");
+    do_assert(b1.insert({ F(bigint(1)), F(bigint(1)), F(bigint(0)), F(bigint(3)) }), "Second row must be independent");
+    do_assert(!b1.insert({ F(bigint(2)), F(bigint(5)), F(bigint(6)), F(bigint(9)) }), "Third row is a combination of the first two");
+    do_assert(b1.rank() == 2 && b1.pivot_columns() == vector<int>{ 0, 1 }, "Wrong rank of b1");
+    do_assert(b1.contains({ F(bigint(1)), F(bigint(0)), F(bigint(-2)), F(bigint(2)) }), "Row must lie in the span of b1");
+    do_assert(!b1.contains({ F(bigint(0)), F(bigint(0)), F(bigint(1)), F(bigint(0)) }), "Row must not lie in the span of b1");
+    cout << "b1 ==\n" << b1.basis() << endl;
+    dynamic_matrix<F> rref(2, 4, { bigint(1), bigint(0), bigint(-2), bigint(2), bigint(0), bigint(1), bigint(2), bigint(1) });
+    do_assert(b1.basis() == rref, "Wrong reduced basis of b1");
+
+    int rows = 200, cols = 60;
+    mt19937 gen(40);
+    uniform_int_distribution<int> dist(0, 4);
+    dynamic_matrix<int_finite_field<5>> m2(rows, cols);
+    echelon_basis<int_finite_field<5>> b2(cols);
+    for (int i = 0; i < rows; i++) {
+        vector<int_finite_field<5>> row(cols);
+        for (int j = 0; j < cols; j++) {
+            row[j] = i < 40 || j % 3 ? dist(gen) : 0;
+            m2.element(i, j) = row[j];
+        }
+        b2.insert(row);
+        if (i % 50 == 49) {
+            dynamic_matrix<int_finite_field<5>> prefix(i + 1, cols);
+            for (int r = 0; r <= i; r++) {
+                for (int c = 0; c < cols; c++) {
+                    prefix.element(r, c) = m2.element(r, c);
+                }
+            }
+            do_assert(b2.rank() == prefix.compute_rank(), "Streaming rank differs from compute_rank");
+        }
+    }
+    dynamic_matrix<int_finite_field<5>> reduced = m2;
+    int rank = reduced.compute_RREF_and_rank();
+    echelon_basis<int_finite_field<5>> b3(cols);
+    do_assert(b3.insert_rows(m2) == rank, "insert_rows must add exactly rank rows");
+    dynamic_matrix<int_finite_field<5>> basis = b3.basis();
+    for (int i = 0; i < rank; i++) {
+        for (int j = 0; j < cols; j++) {
+            do_assert(basis.element(i, j) == reduced.element(i, j), "Streaming basis differs from RREF");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+
+typedef extension_field<3, 2, 1> GF9;
+typedef extension_field<7, 3, 5> GF343;
+
+int run_test() {
+    for (unsigned long long a = 0; a < GF9::size(); a++) {
+        GF9 x = GF9::from_index(a);
+        do_assert(x.index() == a, "Wrong GF(9) element index");
+        if (a)
+            do_assert(x * x.inverse() == GF9(1) && (x ^ 8) == GF9(1), "Wrong GF(9) inverse");
+        for (unsigned long long b = 0; b < GF9::size(); b++) {
+            GF9 y = GF9::from_index(b);
+            do_assert(x * y == y * x && (x + y) - y == x, "GF(9) arithmetic is inconsistent");
+            for (unsigned long long c = 0; c < GF9::size(); c += 4) {
+                GF9 z = GF9::from_index(c);
+                do_assert(x * (y + z) == x * y + x * z && (x * y) * z == x * (y * z), "GF(9) arithmetic is not distributive");
+            }
+        }
+    }
+    GF9 i = GF9::from_index(3);
+    cout << "i == " << i << ", i^2 == " << (i ^ 2) << endl;
+    do_assert((i ^ 2) == GF9(-1), "x^2 must equal -1 in Z_3[x]/(x^2+1)");
+
+    mt19937 gen(44);
+    for (int t = 0; t < 200; t++) {
+        GF343 x = GF343::from_index(gen() % GF343::size());
+        if (x == GF343(0))
+            continue;
+        do_assert(x * x.inverse() == GF343(1) && (x ^ 342) == GF343(1) && (x ^ -2) * (x ^ 2) == GF343(1), "Wrong GF(343) inverse");
+    }
+
+    int n = 12;
+    dynamic_matrix<GF343> m(n, n);
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            m.element(r, c) = GF343::from_index(gen() % GF343::size());
+        }
+    }
+    pair<dynamic_matrix<GF343>, bool> inverse = m.compute_inverse_RREF();
+    do_assert(inverse.second, "Random matrix over GF(343) should be regular");
+    do_assert(m * inverse.first == dynamic_matrix<GF343>::identity(n), "Wrong inverse over GF(343)");
+    do_assert(m.compute_determinant_REF() * inverse.first.compute_determinant_REF() == GF343(1), "Wrong determinant over GF(343)");
+    do_assert((m ^ 5) == m * m * m * m * m, "Wrong matrix power over GF(343)");
+
+    dynamic_matrix<GF9> s(3, 3, { 1, 2, 0, 2, 1, 0, 0, 0, 1 });
+    cout << "s ==\n" << s << endl;
+    do_assert(s.compute_rank() == 2 && s.compute_determinant_REF() == GF9(0), "s is singular over GF(9)");
+
+    return 0;
+}
@@ -44,5 +44,44 @@ int run_test() {
     cout << "m5 ==\n" << m5 << endl;
     cout << "det(m5) ==\n" << m5.compute_determinant_REF() << endl;
 
+    for (int t = 0; t < 50; t++) {
+        int rows = 1 + rand() % 80, cols = t % 2 ? rows : 1 + rand() % 80;
+        dynamic_matrix<int_finite_field<7>> m6(rows, cols);
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                m6[i][j] = i > 1 && t % 3 == 0 ? m6[i - 1][j] + m6[i - 2][j] * j : rand() % 7;
+            }
+        }
+        dynamic_matrix<int_finite_field<7>> ref = m6;
+        pair<int, int_finite_field<7>> rank_det = ref.compute_REF_rank_det();
+        do_assert(m6.compute_rank() == rank_det.first, "Wrong rank over Z_7");
+        if (rows != cols)
+            continue;
+        do_assert(m6.compute_determinant_REF() == rank_det.second, "Wrong determinant over Z_7");
+        dynamic_matrix<int_finite_field<7>> b(rows, 2);
+        for (int i = 0; i < rows * 2; i++) {
+            b[i / 2][i % 2] = rand() % 7;
+        }
+        pair<dynamic_matrix<int_finite_field<7>>, bool> x = m6.solve(b);
+        do_assert(x.second == (rank_det.first == rows), "Wrong regularity over Z_7");
+        do_assert(!x.second || m6 * x.first == b, "Wrong solution over Z_7");
+    }
+    cout << "PLUQ rank, determinant and solve verified" << endl;
+
+    dynamic_matrix<double> d1(2, 2, { 1e-20, 1, 1, 1 }), e1(2, 1, { 1, 2 });
+    pair<dynamic_matrix<double>, bool> y1 = d1.solve(e1);
+    do_assert(y1.second && abs(y1.first[0][0] - 1) < 1e-12 && abs(y1.first[1][0] - 1) < 1e-12, "Solving must pivot on the larger element");
+    int n = 60;
+    dynamic_matrix<double> d2(n, n), e2(n, 1, 1.0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            d2[i][j] = rand() % 201 - 100;
+        }
+    }
+    dynamic_matrix<double> r2 = d2 * d2.solve(e2).first - e2;
+    for (int i = 0; i < n; i++) {
+        do_assert(abs(r2[i][0]) < 1e-9, "Wrong solution of d2 x = 1");
+    }
+
     return 0;
 }
@@ -0,0 +1,60 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+#include "test_helpers.hpp"
+
+using namespace std;
+using namespace matrices;
+
+typedef int_finite_field<2> Z2;
+
+int run_test() {
+    dynamic_matrix<Z2> m1(3, 3, { 1, 1, 0, 0, 1, 1, 1, 0, 0 });
+    gf2_matrix g1(m1);
+    cout << "g1 ==\n" << g1 << endl;
+    do_assert(g1.to_dynamic_matrix() == m1, "Round trip through gf2_matrix changed m1");
+    do_assert(g1.compute_rank() == 3 && g1.compute_determinant() == 1, "g1 is regular");
+    pair<gf2_matrix, bool> inv1 = g1.compute_inverse();
+    do_assert(inv1.second && g1 * inv1.first == gf2_matrix::identity(3), "Wrong inverse of g1");
+    do_assert(inv1.first.to_dynamic_matrix() == m1.compute_inverse_RREF().first, "Inverse of g1 differs from the generic one");
+
+    gf2_matrix g2(dynamic_matrix<Z2>(2, 2, { 1, 1, 1, 1 }));
+    do_assert(!g2.compute_inverse().second && g2.compute_determinant() == 0, "g2 is singular");
+    do_assert(!g2.solve(gf2_matrix(dynamic_matrix<Z2>(2, 1, { 1, 0 }))).second, "System with g2 has no solution");
+
+    mt19937 gen(41);
+    for (int t = 0; t < 6; t++) {
+        int rows = 50 + 37 * t, inner = 70 + 29 * t, cols = 20 + 61 * t;
+        dynamic_matrix<Z2> a = random_matrix<Z2>(gen, rows, inner, 2), b = random_matrix<Z2>(gen, inner, cols, 2);
+        if (t % 2) {
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < inner; j++) {
+                    a.element(i, j) = a.element(i % 17, j);
+                }
+            }
+        }
+        gf2_matrix ga(a), gb(b);
+        do_assert((ga * gb).to_dynamic_matrix() == a * b, "M4RM product differs from the generic one");
+        do_assert((ga + ga) == gf2_matrix(rows, inner), "A + A must be zero");
+        do_assert(ga.transpose().to_dynamic_matrix() == a.transpose(), "Wrong transpose");
+        do_assert(ga.compute_rank() == a.compute_rank(), "M4RI rank differs from the generic one");
+        dynamic_matrix<Z2> rref = a;
+        rref.compute_RREF_and_rank();
+        do_assert(ga.compute_RREF().to_dynamic_matrix() == rref, "M4RI echelon form differs from the generic one");
+
+        dynamic_matrix<Z2> x = random_matrix<Z2>(gen, inner, 3, 2);
+        gf2_matrix gy(a * x);
+        pair<gf2_matrix, bool> solution = ga.solve(gy);
+        do_assert(solution.second && ga * solution.first == gy, "Wrong solution of a consistent system");
+    }
+
+    int n = 300;
+    dynamic_matrix<Z2> a3 = random_matrix<Z2>(gen, n, n, 2);
+    gf2_matrix g3(a3);
+    pair<gf2_matrix, bool> inv3 = g3.compute_inverse();
+    pair<dynamic_matrix<Z2>, bool> generic = a3.compute_inverse_RREF();
+    do_assert(inv3.second == generic.second, "Regularity of a3 differs from the generic one");
+    if (inv3.second)
+        do_assert(inv3.first.to_dynamic_matrix() == generic.first && inv3.first * g3 == gf2_matrix::identity(n), "Wrong inverse of a3");
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+#include "test_helpers.hpp"
+
+using namespace std;
+using namespace matrices;
+using namespace number_utils;
+
+int run_test() {
+    dynamic_matrix<fraction<bigint>> a1(3, 3, { bigint(2), bigint(1), bigint(0), bigint(1), bigint(3), bigint(1), bigint(0), bigint(1), bigint(4) });
+    incremental_inverse<fraction<bigint>> i1(a1);
+    do_assert(i1.update_row(0, { bigint(1), bigint(0), bigint(2) }), "Row update of a1 should succeed");
+    do_assert(i1.update_column(2, { bigint(-1), bigint(5), bigint(0) }), "Column update of a1 should succeed");
+    cout << "a1 ==\n" << i1.matrix() << endl;
+    cout << "a1^-1 ==\n" << i1.inverse() << endl;
+    do_assert(i1.inverse() == i1.matrix().compute_inverse_RREF().first, "Wrong updated inverse of a1");
+    do_assert(i1.matrix() * i1.inverse() == dynamic_matrix<fraction<bigint>>::identity(3), "a1 * a1^-1 is not identity");
+
+    dynamic_matrix<int_finite_field<7>> a2(2, 2, { 1, 0, 0, 1 });
+    incremental_inverse<int_finite_field<7>> i2(a2);
+    do_assert(!i2.update(vector<int_finite_field<7>>{ 6, 0 }, vector<int_finite_field<7>>{ 1, 0 }), "Update making a2 singular must be rejected");
+    do_assert(i2.matrix() == a2 && i2.inverse() == a2, "Rejected update must not change a2");
+
+    int n = 40, k = 3;
+    mt19937 gen(39);
+    uniform_int_distribution<int> dist(0, 32748);
+    dynamic_matrix<int_finite_field<32749>> a3(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a3.element(i, j) = dist(gen);
+        }
+    }
+    incremental_inverse<int_finite_field<32749>> i3(a3);
+    for (int step = 0; step < 5; step++) {
+        dynamic_matrix<int_finite_field<32749>> u(n, k), v(n, k);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < k; j++) {
+                u.element(i, j) = dist(gen);
+                v.element(i, j) = dist(gen);
+            }
+        }
+        if (i3.update(u, v))
+            do_assert(i3.inverse() == i3.matrix().compute_inverse_RREF().first, "Wrong updated inverse over Z_32749");
+    }
+
+    uniform_real_distribution<double> real(-1, 1);
+    dynamic_matrix<double> a4(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a4.element(i, j) = real(gen) + (i == j ? n : 0);
+        }
+    }
+    incremental_inverse<double> i4(a4, 8);
+    for (int step = 0; step < 20; step++) {
+        vector<double> delta(n);
+        for (double& x : delta) {
+            x = real(gen);
+        }
+        do_assert(step % 2 ? i4.update_column(step % n, delta) : i4.update_row(step % n, delta), "Update of a4 should succeed");
+    }
+    double diff = max_difference(i4.matrix() * i4.inverse(), dynamic_matrix<double>::identity(n));
+    cout << "max |a4 * a4^-1 - I| == " << diff << endl;
+    do_assert(diff < 1e-10, "Updated inverse of a4 is inaccurate");
+
+    incremental_inverse<double> i5(dynamic_matrix<double>(2, 2, { 1e-20, 1, 1, 1 }), 1);
+    do_assert(max_difference(i5.inverse(), dynamic_matrix<double>(2, 2, { -1, 1, 1, 0 })) < 1e-12, "Inverse must pivot on the larger element");
+    do_assert(i5.update_row(0, { 1, 1 }) && max_difference(i5.inverse(), dynamic_matrix<double>(2, 2, { -1, 2, 1, -1 })) < 1e-12, "Refactored inverse after an update is wrong");
+
+    return 0;
+}
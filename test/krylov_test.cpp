@@ -0,0 +1,90 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+
+sparse_matrix<double> grid_operator(int side, double convection) {
+    vector<tuple<int, int, double>> triplets;
+    for (int i = 0; i < side; i++) {
+        for (int j = 0; j < side; j++) {
+            int id = i * side + j;
+            triplets.emplace_back(id, id, 4.0);
+            if (i > 0)
+                triplets.emplace_back(id, id - side, -1.0 - convection);
+            if (i + 1 < side)
+                triplets.emplace_back(id, id + side, -1.0 + convection);
+            if (j > 0)
+                triplets.emplace_back(id, id - 1, -1.0);
+            if (j + 1 < side)
+                triplets.emplace_back(id, id + 1, -1.0);
+        }
+    }
+    return sparse_matrix<double>(side * side, side * side, triplets);
+}
+
+template <typename Op>
+void check_result(const Op& a, const krylov_result<double>& result, const vector<double>& b, double tolerance) {
+    do_assert(result.converged, "Krylov solver did not converge");
+    do_assert((int)result.residuals.size() >= result.iterations && result.residuals.back() <= tolerance, "Wrong residual history");
+    vector<double> r = apply_operator(a, result.x);
+    double error = 0, norm = 0;
+    for (size_t i = 0; i < b.size(); i++) {
+        error += (r[i] - b[i]) * (r[i] - b[i]);
+        norm += b[i] * b[i];
+    }
+    do_assert(sqrt(error / norm) < 10 * tolerance, "Krylov solution has a large residual");
+}
+
+int run_test() {
+    sparse_matrix<double> poisson = grid_operator(40, 0);
+    vector<double> b(poisson.rows());
+    mt19937 gen(48);
+    for (double& v : b) {
+        v = (double)(gen() % 200) / 100 - 1;
+    }
+    krylov_options options;
+    options.tolerance = 1e-9;
+
+    krylov_result<double> plain = conjugate_gradient(poisson, b, identity_preconditioner<double>(), options);
+    krylov_result<double> jacobi = conjugate_gradient(poisson, b, jacobi_preconditioner<double>(poisson), options);
+    incomplete_cholesky<double> ic(poisson);
+    krylov_result<double> cholesky = conjugate_gradient(poisson, b, ic, options);
+    cout << "CG iterations: plain " << plain.iterations << ", Jacobi " << jacobi.iterations << ", IC(0) " << cholesky.iterations << endl;
+    check_result(poisson, plain, b, options.tolerance);
+    check_result(poisson, jacobi, b, options.tolerance);
+    check_result(poisson, cholesky, b, options.tolerance);
+    do_assert(ic.shift() == 0 && cholesky.iterations < plain.iterations / 2, "IC(0) must accelerate CG on the Poisson matrix");
+    do_assert((int)plain.residuals.size() == plain.iterations + 1, "CG must record one residual per iteration");
+
+    sparse_matrix<double> convection = grid_operator(30, 0.4);
+    vector<double> c(convection.rows(), 1.0);
+    krylov_result<double> stab = bicgstab(convection, c, jacobi_preconditioner<double>(convection), options);
+    options.restart = 20;
+    krylov_result<double> restarted = gmres(convection, c, identity_preconditioner<double>(), options);
+    krylov_result<double> preconditioned = gmres(convection, c, incomplete_cholesky<double>(convection), options);
+    cout << "BiCGSTAB iterations " << stab.iterations << ", GMRES(20) " << restarted.iterations << ", preconditioned GMRES(20) " << preconditioned.iterations << endl;
+    check_result(convection, stab, c, options.tolerance);
+    check_result(convection, restarted, c, options.tolerance);
+    check_result(convection, preconditioned, c, options.tolerance);
+    for (size_t i = 1; i < restarted.residuals.size(); i++) {
+        do_assert(restarted.residuals[i] <= restarted.residuals[i - 1] * (1 + 1e-9), "GMRES residuals must not increase");
+    }
+
+    int n = 30;
+    dynamic_matrix<double> dense(n, n, 0.0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            dense.element(i, j) = 1.0 / (1 + abs(i - j));
+        }
+        dense.element(i, i) += n;
+    }
+    vector<double> d(n, 1.0);
+    check_result(dense, conjugate_gradient(dense, d, jacobi_preconditioner<double>(dense), options), d, options.tolerance);
+    check_result(dense, gmres(dense, d, incomplete_cholesky<double>(dense), options), d, options.tolerance);
+
+    options.max_iterations = 3;
+    krylov_result<double> limited = conjugate_gradient(poisson, b, identity_preconditioner<double>(), options);
+    do_assert(!limited.converged && limited.iterations == 3, "Iteration limit must be respected");
+    return 0;
+}
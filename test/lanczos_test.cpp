@@ -0,0 +1,91 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+
+template <typename Op>
+void check_pairs(const Op& a, const eigen_result<double>& result, const vector<double>& expected, double tolerance) {
+    do_assert(result.converged && result.values.size() == expected.size(), "Eigen solver did not converge");
+    for (size_t i = 0; i < expected.size(); i++) {
+        do_assert(abs(result.values[i] - expected[i]) < tolerance * abs(expected[0]), "Wrong eigenvalue");
+        vector<double> r = apply_operator(a, result.vectors[i]);
+        double error = 0, norm = 0;
+        for (size_t j = 0; j < r.size(); j++) {
+            error += (r[j] - result.values[i] * result.vectors[i][j]) * (r[j] - result.values[i] * result.vectors[i][j]);
+            norm += result.vectors[i][j] * result.vectors[i][j];
+        }
+        do_assert(abs(norm - 1) < 1e-8 && sqrt(error) < 1e3 * tolerance * abs(expected[0]), "Wrong eigenvector");
+    }
+}
+
+int run_test() {
+    int n = 2000;
+    vector<tuple<int, int, double>> triplets;
+    vector<double> spectrum;
+    for (int i = 0; i < n / 2; i++) {
+        double a = 10 * pow((double)i / (n / 2), 3);
+        triplets.emplace_back(2 * i, 2 * i, a);
+        triplets.emplace_back(2 * i + 1, 2 * i + 1, a);
+        triplets.emplace_back(2 * i, 2 * i + 1, 1.0);
+        triplets.emplace_back(2 * i + 1, 2 * i, 1.0);
+        spectrum.push_back(a + 1);
+        spectrum.push_back(a - 1);
+    }
+    sparse_matrix<double> blocks(n, n, triplets);
+    sort(spectrum.rbegin(), spectrum.rend());
+    vector<double> top(spectrum.begin(), spectrum.begin() + 5);
+
+    eigen_options options;
+    options.tolerance = 1e-10;
+    eigen_result<double> plain = lanczos(blocks, 5, options);
+    cout << "Lanczos iterations " << plain.iterations << endl;
+    check_pairs(blocks, plain, top, 1e-8);
+
+    options.basis_size = 24;
+    eigen_result<double> thick = thick_restart_lanczos(blocks, 5, options);
+    cout << "Thick-restart Lanczos matrix-vector products " << thick.iterations << endl;
+    check_pairs(blocks, thick, top, 1e-8);
+
+    int m = 60;
+    mt19937 gen(49);
+    dynamic_matrix<double> dense(m, m, 0.0);
+    vector<double> flat((size_t)m * m);
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j <= i; j++) {
+            dense.element(i, j) = dense.element(j, i) = (double)(gen() % 2000) / 1000 - 1;
+        }
+        dense.element(i, i) += i < 3 ? 20 - 4 * i : 0;
+    }
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < m; j++) {
+            flat[(size_t)i * m + j] = dense.element(i, j);
+        }
+    }
+    vector<double> exact = helper::symmetric_eigen_impl<double>::decompose(flat, m, eigen_target::largest_magnitude).first;
+    options = eigen_options();
+    check_pairs(dense, lanczos(dense, 3, options), vector<double>(exact.begin(), exact.begin() + 3), 1e-9);
+    check_pairs(dense, power_iteration(dense, options), vector<double>(1, exact[0]), 1e-9);
+
+    options.max_iterations = 4;
+    do_assert(!power_iteration(dense, options).converged, "Power iteration must respect the iteration limit");
+
+    vector<tuple<int, int, double>> signed_triplets;
+    for (int i = 0; i < 100; i++) {
+        double a = i == 0 ? -10 : 5.0 * i / 100;
+        signed_triplets.emplace_back(2 * i, 2 * i, a);
+        signed_triplets.emplace_back(2 * i + 1, 2 * i + 1, a);
+        signed_triplets.emplace_back(2 * i, 2 * i + 1, 1.0);
+        signed_triplets.emplace_back(2 * i + 1, 2 * i, 1.0);
+    }
+    sparse_matrix<double> signed_blocks(200, 200, signed_triplets);
+    options = eigen_options();
+    check_pairs(signed_blocks, lanczos(signed_blocks, 2, options), { -11, -9 }, 1e-8);
+    check_pairs(signed_blocks, power_iteration(signed_blocks, options), { -11 }, 1e-8);
+    options.target = eigen_target::largest_algebraic;
+    check_pairs(signed_blocks, lanczos(signed_blocks, 1, options), { 1 + 5.0 * 99 / 100 }, 1e-8);
+    options.basis_size = 20;
+    options.target = eigen_target::smallest_algebraic;
+    check_pairs(signed_blocks, thick_restart_lanczos(signed_blocks, 2, options), { -11, -9 }, 1e-8);
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+using namespace number_utils;
+
+int run_test() {
+    dynamic_matrix<double> m1(3, 3, { 0, 2, 1, 4, 1, -3, 2, 5, 7 }), b1(3, 2, { 1, 0, 2, 1, 3, -1 });
+    lu_decomposition<double> lu1(m1);
+    cout << "m1 ==\n" << m1 << endl;
+    cout << "L ==\n" << lu1.lower() << endl;
+    cout << "U ==\n" << lu1.upper() << endl;
+    do_assert(!lu1.is_singular(), "m1 is regular");
+    do_assert(abs(lu1.determinant() - m1.compute_determinant_REF()) < 1e-9, "Wrong determinant of m1");
+
+    dynamic_matrix<double> x1 = lu1.solve(b1), r1 = m1 * x1 - b1;
+    cout << "m1 x == b1, x ==\n" << x1 << endl;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 2; j++) {
+            do_assert(abs(r1[i][j]) < 1e-9, "Wrong solution of m1 x = b1");
+        }
+    }
+    vector<double> x2 = lu1.solve(vector<double>{ 1, 2, 3 });
+    for (int i = 0; i < 3; i++) {
+        do_assert(abs(x2[i] - x1[i][0]) < 1e-12, "Wrong solution of m1 x = (1, 2, 3)");
+    }
+
+    int n = 60;
+    dynamic_matrix<double> m2(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            m2[i][j] = rand() % 201 - 100;
+        }
+    }
+    pair<dynamic_matrix<double>, bool> inv2 = lu_decomposition<double>(m2).inverse();
+    do_assert(inv2.second, "m2 should be regular");
+    dynamic_matrix<double> e2 = m2 * inv2.first - dynamic_matrix<double>::identity(n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            do_assert(abs(e2[i][j]) < 1e-9, "Wrong inverse of m2");
+        }
+    }
+    cout << "m2 * m2^-1 verified" << endl;
+
+    dynamic_matrix<int_finite_field<7>> m3(3, 3, { 1, 2, 3, 2, 4, 1, 3, 1, 5 });
+    lu_decomposition<int_finite_field<7>> lu3(m3);
+    do_assert(lu3.determinant() == m3.compute_determinant_REF(), "Wrong determinant of m3");
+    do_assert(m3 * lu3.inverse().first == dynamic_matrix<int_finite_field<7>>::identity(3), "Wrong inverse of m3");
+
+    dynamic_matrix<double> m4(2, 2, { 1, 2, 2, 4 });
+    lu_decomposition<double> lu4(m4);
+    do_assert(lu4.is_singular() && !lu4.inverse().second, "m4 is singular");
+    do_assert(lu4.determinant() == 0, "det(m4) == 0");
+    bool thrown = false;
+    try {
+        lu4.solve(vector<double>{ 1, 1 });
+    } catch (exceptions::assert_error& e) {
+        thrown = true;
+    }
+    do_assert(thrown, "Solving with a singular matrix must fail");
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+
+int run_test() {
+    int n = 200;
+    dynamic_matrix<double> a1(n, n), b1(n, 2);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a1[i][j] = (rand() % 2001 - 1000) / 1000.0 + (i == j ? 20 : 0);
+        }
+        b1[i][0] = rand() % 100;
+        b1[i][1] = rand() % 100;
+    }
+    mixed_precision_solver s1(a1);
+    dynamic_matrix<double> x1 = s1.solve(b1), exact = lu_decomposition<double>(a1).solve(b1);
+    cout << "refinement iterations: " << s1.last_iterations() << endl;
+    do_assert(!s1.used_fallback(), "a1 should be solved by refinement");
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < 2; j++) {
+            do_assert(abs(x1[i][j] - exact[i][j]) < 1e-12 * max(1.0, abs(exact[i][j])), "Wrong refined solution of a1 x = b1");
+        }
+    }
+
+    int m = 11;
+    dynamic_matrix<double> hilbert(m, m);
+    vector<double> ones(m, 1), b2(m, 0);
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < m; j++) {
+            hilbert[i][j] = 1.0 / (i + j + 1);
+            b2[i] += hilbert[i][j];
+        }
+    }
+    mixed_precision_solver s2(hilbert);
+    vector<double> x2 = s2.solve(b2);
+    cout << "Hilbert matrix fallback: " << s2.used_fallback() << endl;
+    do_assert(s2.used_fallback(), "Refinement of an ill-conditioned matrix should fall back");
+    do_assert(x2 == lu_decomposition<double>(hilbert).solve(b2), "Fallback must match the double factorization");
+
+    return 0;
+}
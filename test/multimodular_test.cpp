@@ -0,0 +1,60 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+using namespace number_utils;
+
+int run_test() {
+    dynamic_matrix<bigint> m1(3, 3, { 2, 1, 1, 1, 3, 2, 1, 0, 0 }), m2(2, 2, { 1, 2, 2, 4 });
+    dynamic_matrix<fraction<bigint>> m3(3, 3), m4(3, 3);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            m3[i][j] = fraction<bigint>(m1[i][j]);
+        }
+    }
+    m4 = { fraction<bigint>(1, 2), fraction<bigint>(1, 3), fraction<bigint>(1, 4),
+           fraction<bigint>(1, 3), fraction<bigint>(1, 4), fraction<bigint>(1, 5),
+           fraction<bigint>(1, 4), fraction<bigint>(1, 5), fraction<bigint>(1, 6) };
+
+    cout << "m1 ==\n" << m1 << endl;
+    cout << "m1 ^ -1 ==\n" << compute_inverse_multimodular(m1).first << endl;
+    do_assert(compute_inverse_multimodular(m1).first == m3.compute_inverse_RREF().first, "Wrong inverse of m1");
+    do_assert(!compute_inverse_multimodular(m2).second, "m2 is singular");
+
+    cout << "m4 ==\n" << m4 << endl;
+    cout << "m4 ^ -1 ==\n" << compute_inverse_multimodular(m4).first << endl;
+    do_assert(compute_inverse_multimodular(m4).first == m4.compute_inverse_RREF().first, "Wrong inverse of m4");
+
+    int n = 12;
+    dynamic_matrix<bigint> m5(n, n);
+    dynamic_matrix<fraction<bigint>> m6(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int x = rand() % 2001 - 1000;
+            m5[i][j] = x;
+            m6[i][j] = fraction<bigint>(x);
+        }
+    }
+    pair<dynamic_matrix<fraction<bigint>>, bool> inverse = compute_inverse_multimodular(m5);
+    do_assert(inverse.second, "m5 should be invertible");
+    do_assert(inverse.first * m6 == dynamic_matrix<fraction<bigint>>::identity(n), "Wrong inverse of m5");
+    cout << "m5 ^ -1 verified" << endl;
+
+    dynamic_matrix<bigint> m7(4, 3), m8(3, 5);
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 3; j++) {
+            m7[i][j] = (bigint(rand()) << 70) - bigint(rand());
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 5; j++) {
+            m8[i][j] = bigint(rand() % 2001 - 1000) * (bigint(rand()) << 40);
+        }
+    }
+    cout << "m7 * m8 ==\n" << multiply_multimodular(m7, m8) << endl;
+    do_assert(multiply_multimodular(m7, m8) == m7 * m8, "Wrong product m7 * m8");
+    do_assert(multiply_multimodular(m5, m5) == m5 * m5, "Wrong product m5 * m5");
+
+    return 0;
+}
@@ -52,6 +52,29 @@ int run_test() {
     cout << (fib ^ 200) << endl;
     cout << "fib ^ 400 ==\n";
     cout << (fib ^ 400) << endl;
+
+    const int P = 16777213, n = 70;
+    dynamic_matrix<int_finite_field<P>> m5(n, n), m6(n, n);
+    vector<long long> a(n * n), b(n * n);
+    for (int i = 0; i < n * n; i++) {
+        a[i] = rand() % P;
+        b[i] = rand() % P;
+        m5[i / n][i % n] = a[i];
+        m6[i / n][i % n] = b[i];
+    }
+    dynamic_matrix<int_finite_field<P>> m7 = m5 * m6;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            long long sum = 0;
+            for (int k = 0; k < n; k++) {
+                sum = (sum + a[i * n + k] * b[k * n + j]) % P;
+            }
+            do_assert(m7[i][j] == (int)sum, "Wrong product in Z_p");
+        }
+    }
+    m5 *= m6;
+    do_assert(m5 == m7, "Wrong product in Z_p");
+    cout << "m5 * m6 in Z_" << P << " verified" << endl;
     
     return 0;
 }
@@ -0,0 +1,68 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+#include "test_helpers.hpp"
+
+using namespace std;
+using namespace matrices;
+
+template <int P>
+void compare_with_generic(mt19937& gen) {
+    for (int t = 0; t < 4; t++) {
+        int rows = 30 + 41 * t, inner = 45 + 23 * t, cols = 10 + 57 * t;
+        dynamic_matrix<int_finite_field<P>> a = random_matrix<int_finite_field<P>>(gen, rows, inner, P), b = random_matrix<int_finite_field<P>>(gen, inner, cols, P);
+        if (t % 2) {
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < inner; j++) {
+                    a.element(i, j) = a.element(i % 13, j) * (i + 1);
+                }
+            }
+        }
+        packed_matrix<P> pa(a), pb(b);
+        do_assert(pa.to_dynamic_matrix() == a, "Round trip through packed_matrix changed the matrix");
+        do_assert((pa * pb).to_dynamic_matrix() == a * b, "Packed product differs from the generic one");
+        do_assert((pa + pa - pa) == pa && (pa - pa) == packed_matrix<P>(rows, inner), "Wrong packed addition");
+        do_assert(pa.compute_rank() == a.compute_rank(), "Packed rank differs from the generic one");
+        dynamic_matrix<int_finite_field<P>> rref = a;
+        rref.compute_RREF_and_rank();
+        do_assert(pa.compute_RREF().to_dynamic_matrix() == rref, "Packed echelon form differs from the generic one");
+
+        dynamic_matrix<int_finite_field<P>> s = random_matrix<int_finite_field<P>>(gen, inner, inner, P);
+        packed_matrix<P> ps(s);
+        do_assert(ps.compute_determinant() == s.compute_determinant_REF(), "Packed determinant differs from the generic one");
+        pair<packed_matrix<P>, bool> inverse = ps.compute_inverse();
+        pair<dynamic_matrix<int_finite_field<P>>, bool> generic = s.compute_inverse_RREF();
+        do_assert(inverse.second == generic.second, "Packed regularity differs from the generic one");
+        if (inverse.second)
+            do_assert(inverse.first.to_dynamic_matrix() == generic.first && ps * inverse.first == packed_matrix<P>::identity(inner),
+                      "Wrong packed inverse");
+    }
+}
+
+int run_test() {
+    dynamic_matrix<int_finite_field<3>> m1(3, 3, { 1, 2, 0, 2, 2, 1, 0, 1, 2 });
+    packed_matrix<3> p1(m1);
+    cout << "p1 ==\n" << p1.to_dynamic_matrix() << endl;
+    do_assert(p1.compute_determinant() == m1.compute_determinant_REF(), "Wrong determinant of p1");
+    do_assert(p1 * p1.compute_inverse().first == packed_matrix<3>::identity(3), "Wrong inverse of p1");
+
+    packed_matrix<251> p2(2, 3);
+    p2.set(0, 0, 250);
+    p2.set(1, 2, 7);
+    do_assert(p2.get(0, 0) == 250 && p2.get(1, 2) == 7 && p2.get(0, 1) == 0, "Wrong element access");
+
+    mt19937 gen(42);
+    compare_with_generic<3>(gen);
+    compare_with_generic<251>(gen);
+    compare_with_generic<32749>(gen);
+
+    int n = 400;
+    packed_matrix<251> ones(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            ones.set(i, j, 250);
+        }
+    }
+    do_assert((ones * ones).get(0, 0) == int_finite_field<251>(n), "Lazy reduction of the packed product overflowed");
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+#include "test_helpers.hpp"
+
+using namespace std;
+using namespace matrices;
+
+int run_test() {
+    dynamic_matrix<double> a1(4, 2, { 1, 1, 1, 2, 1, 3, 1, 4 });
+    qr_decomposition<double> qr1(a1);
+    cout << "a1 ==\n" << a1 << endl;
+    cout << "R ==\n" << qr1.r() << endl;
+    vector<double> x1 = qr1.solve_least_squares(vector<double>{ 6, 5, 7, 10 });
+    cout << "least squares line: " << x1[0] << " + " << x1[1] << " t" << endl;
+    do_assert(abs(x1[0] - 3.5) < 1e-12 && abs(x1[1] - 1.4) < 1e-12, "Wrong least squares solution");
+
+    int m = 150, n = 70, k = 3;
+    dynamic_matrix<double> a2(m, n), b2(m, k);
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+            a2[i][j] = (rand() % 2001 - 1000) / 100.0;
+        }
+        for (int j = 0; j < k; j++) {
+            b2[i][j] = (rand() % 2001 - 1000) / 100.0;
+        }
+    }
+    qr_decomposition<double> qr2(a2);
+    dynamic_matrix<double> q2 = qr2.thin_q();
+    do_assert(max_difference(q2 * qr2.r(), a2) < 1e-9, "Q R != A");
+    do_assert(max_difference(q2.transpose() * q2, dynamic_matrix<double>::identity(n)) < 1e-12, "Q is not orthonormal");
+    do_assert(max_difference(qr2.apply_q(qr2.apply_qt(b2)), b2) < 1e-12, "Q Q^T b != b");
+
+    dynamic_matrix<double> x2 = qr2.solve_least_squares(b2), at2 = a2.transpose();
+    dynamic_matrix<double> normal = lu_decomposition<double>(at2 * a2).solve(at2 * b2);
+    do_assert(max_difference(x2, normal) < 1e-9, "Wrong least squares solution of a2 x = b2");
+    cout << "QR of a2 verified" << endl;
+
+    bool thrown = false;
+    try {
+        qr_decomposition<double> wide(dynamic_matrix<double>(2, 3));
+    } catch (exceptions::assert_error& e) {
+        thrown = true;
+    }
+    do_assert(thrown, "QR of a wide matrix must fail");
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+
+template <typename T>
+dynamic_matrix<min_plus<T>> random_graph(mt19937& gen, int n, int edges, int max_weight) {
+    dynamic_matrix<min_plus<T>> out(n, n, min_plus<T>());
+    for (int e = 0; e < edges; e++) {
+        int u = gen() % n, v = gen() % n;
+        out.element(u, v) = out.element(u, v) + min_plus<T>((T)(1 + gen() % max_weight));
+    }
+    return out;
+}
+
+template <typename T>
+vector<vector<T>> floyd_warshall(const dynamic_matrix<min_plus<T>>& graph) {
+    int n = graph.rows();
+    T inf = min_plus<T>::infinity();
+    vector<vector<T>> d(n, vector<T>(n));
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            d[i][j] = i == j ? 0 : graph.element(i, j).value();
+        }
+    }
+    for (int k = 0; k < n; k++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                if (d[i][k] != inf && d[k][j] != inf)
+                    d[i][j] = min(d[i][j], d[i][k] + d[k][j]);
+            }
+        }
+    }
+    return d;
+}
+
+template <typename T>
+void check_shortest_paths(mt19937& gen, int n, int edges) {
+    dynamic_matrix<min_plus<T>> graph = random_graph<T>(gen, n, edges, 20);
+    dynamic_matrix<min_plus<T>> closure = compute_closure(graph);
+    vector<vector<T>> expected = floyd_warshall(graph);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            do_assert(closure.element(i, j).value() == expected[i][j], "Min-plus closure differs from Floyd-Warshall");
+        }
+    }
+    dynamic_matrix<min_plus<T>> step = graph;
+    for (int i = 0; i < n; i++) {
+        step.element(i, i) += min_plus<T>(0);
+    }
+    do_assert((step ^ (n - 1)) == closure, "Repeated squaring must give the closure");
+}
+
+boolean_matrix naive_product(const boolean_matrix& a, const boolean_matrix& b) {
+    boolean_matrix out(a.rows(), b.cols());
+    for (int i = 0; i < a.rows(); i++) {
+        for (int j = 0; j < b.cols(); j++) {
+            bool sum = false;
+            for (int k = 0; k < a.cols() && !sum; k++) {
+                sum = a.get(i, k) && b.get(k, j);
+            }
+            out.set(i, j, sum);
+        }
+    }
+    return out;
+}
+
+boolean_matrix random_boolean(mt19937& gen, int rows, int cols, int density) {
+    boolean_matrix out(rows, cols);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            out.set(i, j, (int)(gen() % 100) < density);
+        }
+    }
+    return out;
+}
+
+int run_test() {
+    dynamic_matrix<min_plus<int>> g1(4, 4, {
+        { min_plus<int>(), 1, 4, min_plus<int>() },
+        { min_plus<int>(), min_plus<int>(), 2, 6 },
+        { min_plus<int>(), min_plus<int>(), min_plus<int>(), 3 },
+        { 1, min_plus<int>(), min_plus<int>(), min_plus<int>() },
+    });
+    dynamic_matrix<min_plus<int>> d1 = compute_closure(g1);
+    cout << "g1 distances ==\n" << d1 << endl;
+    do_assert(d1.element(0, 3).value() == 6 && d1.element(3, 2).value() == 4 && d1.element(1, 0).value() == 6, "Wrong shortest paths in g1");
+    do_assert((g1 ^ 2).element(0, 2).value() == 3 && (g1 ^ 0) == dynamic_matrix<min_plus<int>>::identity(4), "Wrong min-plus power");
+
+    mt19937 gen(50);
+    check_shortest_paths<int>(gen, 40, 120);
+    check_shortest_paths<long long>(gen, 90, 400);
+    check_shortest_paths<double>(gen, 150, 700);
+
+    int n = 60;
+    dynamic_matrix<max_plus<int>> dag(n, n, max_plus<int>());
+    vector<tuple<int, int, int>> edges;
+    for (int e = 0; e < 200; e++) {
+        int u = gen() % n, v = gen() % n;
+        if (u < v) {
+            int w = 1 + gen() % 9;
+            dag.element(u, v) += max_plus<int>(w);
+            edges.emplace_back(u, v, w);
+        }
+    }
+    vector<int> longest(n, max_plus<int>::infinity());
+    longest[0] = 0;
+    sort(edges.begin(), edges.end());
+    for (auto [u, v, w] : edges) {
+        if (longest[u] != max_plus<int>::infinity())
+            longest[v] = max(longest[v], longest[u] + w);
+    }
+    dynamic_matrix<max_plus<int>> paths = compute_closure(dag);
+    for (int v = 0; v < n; v++) {
+        do_assert(paths.element(0, v).value() == longest[v], "Max-plus closure must give the longest paths in a DAG");
+    }
+
+    int m = 300;
+    boolean_matrix reach(m, m);
+    dynamic_matrix<boolean> dense(m, m, false);
+    vector<vector<int>> adjacent(m);
+    for (int e = 0; e < 2 * m; e++) {
+        int u = gen() % m, v = gen() % m;
+        reach.set(u, v, true);
+        dense.element(u, v) = true;
+        adjacent[u].push_back(v);
+    }
+    do_assert(boolean_matrix(dense) == reach && reach.to_dynamic_matrix() == dense, "Wrong boolean matrix conversion");
+    boolean_matrix square = naive_product(reach, reach);
+    do_assert(reach * reach == square, "Packed boolean product differs from the reference");
+    do_assert(boolean_matrix(dense * dense) == square, "Boolean dynamic_matrix product differs from the reference");
+    do_assert((reach ^ 5) == naive_product(naive_product(square, square), reach), "Packed boolean power differs from the reference");
+    do_assert(reach.transpose().transpose() == reach, "Wrong boolean transpose");
+
+    vector<tuple<int, int, int>> shapes = { { 1, 1, 1 }, { 5, 70, 1 }, { 77, 131, 203 }, { 64, 64, 64 }, { 130, 9, 65 }, { 600, 13, 127 } };
+    for (auto [rows, inner, cols] : shapes) {
+        for (int density : { 3, 30 }) {
+            boolean_matrix a = random_boolean(gen, rows, inner, density), b = random_boolean(gen, inner, cols, density);
+            boolean_matrix expected = naive_product(a, b);
+            do_assert(a * b == expected, "Packed boolean product of a non-square shape differs from the reference");
+            do_assert(boolean_matrix(a.to_dynamic_matrix() * b.to_dynamic_matrix()) == expected, "Boolean dynamic_matrix product of a non-square shape differs from the reference");
+            boolean_matrix at = a.transpose();
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < inner; j++) {
+                    do_assert(at.get(j, i) == a.get(i, j), "Wrong transpose of a non-square boolean matrix");
+                }
+            }
+        }
+    }
+
+    boolean_matrix closure = reach.compute_closure();
+    for (int s = 0; s < m; s += 37) {
+        vector<bool> seen(m, false);
+        vector<int> queue{ s };
+        seen[s] = true;
+        for (size_t q = 0; q < queue.size(); q++) {
+            for (int v : adjacent[queue[q]]) {
+                if (!seen[v]) {
+                    seen[v] = true;
+                    queue.push_back(v);
+                }
+            }
+        }
+        for (int v = 0; v < m; v++) {
+            do_assert(closure.get(s, v) == seen[v], "Boolean closure differs from BFS reachability");
+        }
+    }
+    dynamic_matrix<boolean> generic_closure = compute_closure(dense);
+    for (int s = 0; s < m; s += 37) {
+        for (int v = 0; v < m; v++) {
+            do_assert(generic_closure.element(s, v).value() == closure.get(s, v), "Boolean dynamic_matrix closure differs from BFS reachability");
+        }
+    }
+    return 0;
+}
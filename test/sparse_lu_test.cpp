@@ -0,0 +1,131 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+
+template <typename T, typename G>
+vector<tuple<int, int, T>> random_pattern(mt19937& gen, int n, int per_row, bool diagonal, const G& make) {
+    vector<tuple<int, int, T>> triplets;
+    for (int i = 0; i < n; i++) {
+        if (diagonal)
+            triplets.emplace_back(i, i, make(4 * per_row + 1 + gen() % 5));
+        for (int t = 0; t < per_row; t++) {
+            triplets.emplace_back(i, gen() % n, make(1 + gen() % 3));
+        }
+    }
+    return triplets;
+}
+
+template <typename T>
+vector<T> residual(const sparse_matrix<T>& a, const vector<T>& x, const vector<T>& b) {
+    vector<T> r = a * x;
+    for (size_t i = 0; i < r.size(); i++) {
+        r[i] -= b[i];
+    }
+    return r;
+}
+
+int run_test() {
+    int n = 60;
+    vector<tuple<int, int, double>> arrow;
+    for (int i = 0; i < n; i++) {
+        arrow.emplace_back(i, i, 4.0);
+        if (i > 0) {
+            arrow.emplace_back(0, i, 1.0);
+            arrow.emplace_back(i, 0, 1.0);
+        }
+    }
+    sparse_matrix<double> a1(n, n, arrow);
+    sparse_lu<double> natural(a1, sparse_ordering::natural), ordered(a1);
+    cout << "arrow matrix fill: natural " << natural.non_zeros() << ", minimum degree " << ordered.non_zeros() << endl;
+    do_assert(ordered.non_zeros() == a1.non_zeros(), "Minimum degree ordering must avoid fill on an arrow matrix");
+    do_assert(natural.non_zeros() > 10 * ordered.non_zeros(), "Natural ordering of an arrow matrix must fill in");
+    vector<double> b1(n, 1.0);
+    for (double r : residual(a1, ordered.solve(b1), b1)) {
+        do_assert(abs(r) < 1e-12, "Wrong sparse LU solution of the arrow matrix");
+    }
+    do_assert(abs(ordered.determinant() - a1.to_dynamic_matrix().compute_determinant_REF()) < 1e-6 * abs(ordered.determinant()), "Wrong sparse LU determinant");
+
+    int g = 40;
+    vector<tuple<int, int, double>> grid;
+    for (int i = 0; i < g * g; i++) {
+        grid.emplace_back(i, i, 4.0);
+        if (i % g + 1 < g) {
+            grid.emplace_back(i, i + 1, -1.0);
+            grid.emplace_back(i + 1, i, -1.0);
+        }
+        if (i + g < g * g) {
+            grid.emplace_back(i, i + g, -1.0);
+            grid.emplace_back(i + g, i, -1.0);
+        }
+    }
+    sparse_matrix<double> a_grid(g * g, g * g, grid);
+    vector<int> order = helper::minimum_degree_order(g * g, a_grid.row_starts(), a_grid.column_indices());
+    vector<int> sorted_order = order;
+    sort(sorted_order.begin(), sorted_order.end());
+    for (int i = 0; i < g * g; i++) {
+        do_assert(sorted_order[i] == i, "Minimum degree order must be a permutation");
+    }
+    sparse_lu<double> grid_natural(a_grid, sparse_ordering::natural), grid_ordered(a_grid);
+    cout << "grid fill: natural " << grid_natural.non_zeros() << ", minimum degree " << grid_ordered.non_zeros() << endl;
+    do_assert(2 * grid_ordered.non_zeros() < grid_natural.non_zeros(), "Minimum degree ordering must reduce fill on a grid");
+
+    mt19937 gen(46);
+    auto real = [](int x) { return (double)x; };
+    vector<tuple<int, int, double>> t2 = random_pattern<double>(gen, 300, 3, true, real);
+    sparse_matrix<double> a2(300, 300, t2);
+    sparse_lu<double> lu2(a2);
+    vector<double> b2(300);
+    for (double& v : b2) {
+        v = (double)(gen() % 100) - 50;
+    }
+    for (double r : residual(a2, lu2.solve(b2), b2)) {
+        do_assert(abs(r) < 1e-9, "Wrong sparse LU solution of a random system");
+    }
+
+    int nonzeros = lu2.non_zeros();
+    for (auto& t : t2) {
+        get<2>(t) *= 1.0 + (gen() % 7) / 10.0;
+    }
+    sparse_matrix<double> a3(300, 300, t2);
+    do_assert(lu2.refactor(a3) && lu2.non_zeros() == nonzeros, "Refactoring with the same pattern must succeed");
+    for (double r : residual(a3, lu2.solve(b2), b2)) {
+        do_assert(abs(r) < 1e-9, "Wrong sparse LU solution after refactoring");
+    }
+
+    sparse_matrix<double> a4(2, 2, { make_tuple(0, 0, 1.0), make_tuple(0, 1, 1.0), make_tuple(1, 0, 1.0), make_tuple(1, 1, 2.0) });
+    sparse_matrix<double> a5(2, 2, { make_tuple(0, 0, 1e-30), make_tuple(0, 1, 1.0), make_tuple(1, 0, 1.0), make_tuple(1, 1, 2.0) });
+    sparse_lu<double> lu4(a4, sparse_ordering::natural);
+    do_assert(!lu4.refactor(a5), "Refactor must reject a pivot below the threshold");
+    lu4.factorize(a5);
+    vector<double> x5 = lu4.solve(vector<double>{ 1.0, 3.0 });
+    do_assert(abs(x5[0] - 1.0) < 1e-12 && abs(x5[1] - 1.0) < 1e-12, "Factorize must pivot away from a tiny diagonal");
+
+    typedef int_finite_field<10007> F;
+    auto field = [](int x) { return F(x); };
+    vector<tuple<int, int, F>> t6 = random_pattern<F>(gen, 80, 3, false, field);
+    for (int i = 0; i < 80; i++) {
+        t6.emplace_back(i, (i * 7 + 3) % 80, F(1 + gen() % 9));
+    }
+    sparse_matrix<F> a6(80, 80, t6);
+    sparse_lu<F> lu6(a6);
+    dynamic_matrix<F> d6 = a6.to_dynamic_matrix();
+    do_assert(lu6.determinant() == d6.compute_determinant_REF(), "Wrong sparse LU determinant over a finite field");
+    if (!lu6.is_singular()) {
+        vector<F> b6(80);
+        for (F& v : b6) {
+            v = F(gen() % 10007);
+        }
+        for (F r : residual(a6, lu6.solve(b6), b6)) {
+            do_assert(r == F(0), "Wrong sparse LU solution over a finite field");
+        }
+        dynamic_matrix<F> x6 = lu6.solve(dynamic_matrix<F>::identity(80));
+        do_assert(d6 * x6 == dynamic_matrix<F>::identity(80), "Sparse LU inverse over a finite field is wrong");
+    }
+
+    sparse_matrix<F> a7(3, 3, { make_tuple(0, 0, F(1)), make_tuple(0, 1, F(2)), make_tuple(1, 0, F(2)), make_tuple(1, 1, F(4)), make_tuple(2, 2, F(5)) });
+    sparse_lu<F> lu7(a7);
+    do_assert(lu7.is_singular() && lu7.determinant() == F(0), "Singular sparse matrix must be detected");
+    return 0;
+}
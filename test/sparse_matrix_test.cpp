@@ -0,0 +1,65 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+
+template <typename T, typename G>
+void compare_with_dense(mt19937& gen, const G& make, const T& sample) {
+    int rows = 37, inner = 29, cols = 23;
+    auto random_sparse = [&](int r, int c) {
+        vector<tuple<int, int, T>> triplets;
+        for (int t = 0; t < r * c / 8; t++) {
+            triplets.emplace_back(gen() % r, gen() % c, make(gen() % 9));
+        }
+        return sparse_matrix<T>(r, c, triplets, sample);
+    };
+    sparse_matrix<T> a = random_sparse(rows, inner), b = random_sparse(inner, cols), c = random_sparse(rows, inner);
+    dynamic_matrix<T> da = a.to_dynamic_matrix(), db = b.to_dynamic_matrix(), dc = c.to_dynamic_matrix();
+    do_assert(sparse_matrix<T>(da) == a, "Round trip through dynamic_matrix changed the sparse matrix");
+    do_assert((a * b).to_dynamic_matrix() == da * db, "Sparse x sparse product differs from the dense one");
+    do_assert(a * db == da * db && da * b == da * db, "Sparse x dense product differs from the dense one");
+    do_assert((a + c).to_dynamic_matrix() == da + dc && (a - c).to_dynamic_matrix() == da - dc, "Wrong sparse sum");
+    do_assert((a - a).non_zeros() == 0, "A - A must have no stored entries");
+    do_assert((a * make(3)).to_dynamic_matrix() == da * make(3), "Wrong sparse scaling");
+    do_assert(a.transpose().to_dynamic_matrix() == da.transpose() && a.transpose().transpose() == a, "Wrong sparse transpose");
+
+    vector<T> x(inner, sample), y(rows, sample);
+    for (T& v : x) {
+        v = make(gen() % 9);
+    }
+    for (int i = 0; i < rows; i++) {
+        y[i] = make(0);
+        for (int k = 0; k < inner; k++) {
+            y[i] += da.element(i, k) * x[k];
+        }
+    }
+    do_assert(a * x == y, "Sparse matrix-vector product differs from the dense one");
+}
+
+int run_test() {
+    sparse_matrix<double> m1(3, 4, { make_tuple(0, 1, 2.0), make_tuple(2, 3, -1.0), make_tuple(0, 1, 3.0), make_tuple(1, 0, 0.0) });
+    cout << "m1 ==\n" << m1.to_dynamic_matrix() << endl;
+    do_assert(m1.non_zeros() == 2 && m1.element(0, 1) == 5 && m1.element(1, 0) == 0, "Duplicate triplets must be summed and zeros dropped");
+    do_assert(m1.row_starts() == vector<int>{ 0, 1, 1, 2 } && m1.column_indices() == vector<int>{ 1, 3 }, "Wrong CSR layout of m1");
+
+    mt19937 gen(45);
+    compare_with_dense<double>(gen, [](int x) { return (double)x; }, 0.0);
+    compare_with_dense<int_finite_field<7>>(gen, [](int x) { return int_finite_field<7>(x); }, int_finite_field<7>(0));
+    compare_with_dense<finite_field<long long>>(gen, [](int x) { return finite_field<long long>(11, x); }, finite_field<long long>(11, 0));
+    compare_with_dense<fraction<long long>>(gen, [](int x) { return fraction<long long>(x, 3); }, fraction<long long>(0));
+
+    int n = 100000;
+    vector<tuple<int, int, int_finite_field<5>>> triplets;
+    for (int i = 0; i < n; i++) {
+        triplets.emplace_back(i, (i + 1) % n, 1);
+        triplets.emplace_back(i, (i + 7) % n, 2);
+    }
+    sparse_matrix<int_finite_field<5>> cycle(n, n, triplets);
+    vector<int_finite_field<5>> ones(n, 1);
+    vector<int_finite_field<5>> product = cycle * ones;
+    do_assert(all_of(product.begin(), product.end(), [](const int_finite_field<5>& v) { return v == 3; }), "Wrong product with a large sparse matrix");
+    do_assert((cycle * cycle).non_zeros() == 3 * n, "Wrong sparsity of a large sparse product");
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+template <typename T>
+T max_difference(const matrices::dynamic_matrix<T>& a, const matrices::dynamic_matrix<T>& b) {
+    T diff = 0;
+    for (int i = 0; i < a.rows(); i++) {
+        for (int j = 0; j < a.cols(); j++) {
+            diff = std::max(diff, std::abs(a.element(i, j) - b.element(i, j)));
+        }
+    }
+    return diff;
+}
+
+template <typename T>
+matrices::dynamic_matrix<T> random_matrix(std::mt19937& gen, int rows, int cols, unsigned range) {
+    matrices::dynamic_matrix<T> m(rows, cols);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            m.element(i, j) = T(gen() % range);
+        }
+    }
+    return m;
+}
@@ -0,0 +1,47 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+
+int run_test() {
+    dynamic_matrix<double> l1(3, 3, { 2, 0, 0, 1, 4, 0, -1, 3, 5 }), b1(3, 2, { 2, 4, 9, 6, 12, 10 });
+    dynamic_matrix<double> x1 = solve_triangular(l1, b1, triangle::lower);
+    cout << "l1 ==\n" << l1 << endl;
+    cout << "l1 x == b1, x ==\n" << x1 << endl;
+    do_assert(l1 * x1 == b1, "Wrong solution of l1 x = b1");
+    vector<double> x2 = solve_triangular(l1.transpose(), vector<double>{ 1, 7, 5 }, triangle::upper);
+    do_assert(x2 == vector<double>{ 0.5, 1, 1 }, "Wrong solution of l1^T x = (1, 7, 5)");
+
+    typedef int_finite_field<101> F;
+    int n = 90, k = 7;
+    dynamic_matrix<F> l(n, n, F(0)), u(n, n, F(0)), b(n, k), c(k, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            l[i][j] = j == i ? 1 + rand() % 100 : rand() % 101;
+            u[j][i] = j == i ? 1 + rand() % 100 : rand() % 101;
+        }
+        for (int j = 0; j < k; j++) {
+            b[i][j] = rand() % 101;
+            c[j][i] = rand() % 101;
+        }
+    }
+    do_assert(l * solve_triangular(l, b, triangle::lower) == b, "Wrong lower solve");
+    do_assert(u * solve_triangular(u, b, triangle::upper) == b, "Wrong upper solve");
+    do_assert(solve_triangular(l, c, triangle::lower, false, side::right) * l == c, "Wrong right lower solve");
+    do_assert(solve_triangular(u, c, triangle::upper, false, side::right) * u == c, "Wrong right upper solve");
+
+    dynamic_matrix<F> unit = l;
+    for (int i = 0; i < n; i++) {
+        unit[i][i] = 1;
+    }
+    do_assert(unit * solve_triangular(l, b, triangle::lower, true) == b, "Wrong unit lower solve");
+    cout << "Z_101 triangular solves verified" << endl;
+
+    try {
+        solve_triangular(dynamic_matrix<double>(2, 2, { 1, 0, 1, 0 }), vector<double>{ 1, 1 }, triangle::lower);
+        return 1;
+    } catch (exceptions::assert_error& e) { }
+
+    return 0;
+}
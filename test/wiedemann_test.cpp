@@ -0,0 +1,119 @@
+#include <bits/stdc++.h>
+#include "../src/all.hpp"
+
+using namespace std;
+using namespace matrices;
+
+typedef finite_field_template<long long, 998244353> F;
+
+struct scaled_shift {
+    vector<F> scale;
+
+    int rows() const {
+        return scale.size();
+    }
+
+    int cols() const {
+        return scale.size();
+    }
+
+    vector<F> apply(const vector<F>& x) const {
+        vector<F> y(x.size());
+        for (size_t i = 0; i < x.size(); i++) {
+            y[i] = scale[i] * x[(i + 1) % x.size()];
+        }
+        return y;
+    }
+};
+
+template <typename Op>
+void check_solution(const Op& a, const pair<vector<F>, bool>& x, const vector<F>& b) {
+    do_assert(x.second, "Wiedemann failed to solve a regular system");
+    do_assert(apply_operator(a, x.first) == b, "Wrong Wiedemann solution");
+}
+
+int run_test() {
+    mt19937 gen(47);
+    auto random_field = [&]() { return F((long long)(gen() % 998244353)); };
+
+    int n = 40;
+    dynamic_matrix<F> a1(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a1.element(i, j) = random_field();
+        }
+    }
+    wiedemann_solver<F> solver;
+    do_assert(solver.determinant(a1) == a1.compute_determinant_REF(), "Wrong Wiedemann determinant of a dense matrix");
+    vector<F> b1(n);
+    for (F& v : b1) {
+        v = random_field();
+    }
+    check_solution(a1, solver.solve(a1, b1), b1);
+
+    vector<F> poly = solver.minimal_polynomial(a1);
+    do_assert((int)poly.size() == n + 1 && poly.back() == F(1), "Minimal polynomial of a random matrix must be its characteristic polynomial");
+    dynamic_matrix<F> value(n, n, F(0)), power = dynamic_matrix<F>::identity(n);
+    for (const F& c : poly) {
+        value += power * c;
+        power *= a1;
+    }
+    do_assert(value == dynamic_matrix<F>(n, n, F(0)), "Minimal polynomial must vanish at the matrix");
+
+    dynamic_matrix<F> left(30, 7), right(7, 25);
+    for (int i = 0; i < 30; i++) {
+        for (int j = 0; j < 7; j++) {
+            left.element(i, j) = random_field();
+        }
+    }
+    for (int i = 0; i < 7; i++) {
+        for (int j = 0; j < 25; j++) {
+            right.element(i, j) = random_field();
+        }
+    }
+    dynamic_matrix<F> low_rank = left * right;
+    do_assert(solver.rank(low_rank) == 7, "Wrong Wiedemann rank of a rectangular matrix");
+
+    int m = 1000;
+    vector<tuple<int, int, F>> triplets;
+    for (int i = 0; i < m; i++) {
+        triplets.emplace_back(i, i, random_field());
+        triplets.emplace_back(i, gen() % m, random_field());
+        triplets.emplace_back(i, gen() % m, random_field());
+    }
+    sparse_matrix<F> a2(m, m, triplets);
+    wiedemann_solver<F> block_solver(4, 7);
+    vector<F> b2(m);
+    for (F& v : b2) {
+        v = random_field();
+    }
+    check_solution(a2, block_solver.solve(a2, b2), b2);
+    do_assert(block_solver.rank(a2) == m, "Random sparse matrix must have full rank");
+
+    vector<tuple<int, int, F>> small;
+    for (int i = 0; i < 300; i++) {
+        small.emplace_back(i, gen() % 300, random_field());
+        small.emplace_back(i, gen() % 300, random_field());
+    }
+    sparse_matrix<F> a3(300, 300, small);
+    do_assert(block_solver.determinant(a3) == sparse_lu<F>(a3).determinant(), "Wiedemann and sparse LU determinants differ");
+
+    scaled_shift shift{ vector<F>(50) };
+    F expected = F(-1);
+    for (F& v : shift.scale) {
+        v = F(1 + gen() % 1000);
+        expected *= v;
+    }
+    do_assert(solver.determinant(shift) == expected, "Wrong Wiedemann determinant of a custom operator");
+    vector<F> b3(50, F(3));
+    check_solution(shift, solver.solve(shift, b3), b3);
+
+    dynamic_matrix<F> singular = low_rank.transpose() * low_rank;
+    do_assert(solver.determinant(singular) == F(0), "Singular matrix must have zero determinant");
+    vector<F> b4(25);
+    for (F& v : b4) {
+        v = random_field();
+    }
+    do_assert(!solver.solve(singular, b4).second, "Solving a singular system must fail");
+    return 0;
+}